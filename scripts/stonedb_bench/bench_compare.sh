@@ -0,0 +1,24 @@
+#!/bin/sh
+#
+# Compare two benchmark reports written by stonedb_bench.sh.
+#
+# usage: bench_compare.sh BASE.tsv NEW.tsv [THRESHOLD_PCT]
+#
+# Prints the warm median and cold time of every query in both reports, and
+# exits with status 1 if any query got slower by more than THRESHOLD_PCT
+# (default: 10) or returned a different result.
+
+[ $# -ge 2 ] || { echo "usage: $0 BASE.tsv NEW.tsv [THRESHOLD_PCT]"; exit 2; }
+
+awk -F'\t' -v threshold=${3:-10} '
+    NR == FNR { cold[$1] = $2; warm[$1] = $3; ck[$1] = $4; next }
+    !($1 in warm) { printf "%-6s  only in new report\n", $1; next }
+    {
+        ratio = warm[$1] > 0 ? ($3 - warm[$1]) * 100 / warm[$1] : 0
+        flag = ""
+        if (ratio > threshold) { flag = "  SLOWER"; bad = 1 }
+        if (ck[$1] != $4) { flag = flag "  RESULT CHANGED"; bad = 1 }
+        printf "%-6s  warm %9.1f -> %9.1f ms (%+6.1f%%)  cold %7d -> %7d ms%s\n", $1, warm[$1], $3, ratio, cold[$1], $2, flag
+    }
+    END { exit bad }
+' "$1" "$2"
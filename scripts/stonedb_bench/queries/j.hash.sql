@@ -0,0 +1,4 @@
+-- join on two non-unique string keys: hash joiner
+SELECT COUNT(*)
+FROM customer, supplier
+WHERE c_city = s_city AND c_nation = s_nation;
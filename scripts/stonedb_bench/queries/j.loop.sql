@@ -0,0 +1,4 @@
+-- join condition on an expression of both tables: general (loop) joiner
+SELECT COUNT(*)
+FROM supplier, part
+WHERE p_partkey <= 2000 AND s_suppkey + p_partkey = 2001;
@@ -0,0 +1,4 @@
+-- join on a dense unique integer key: map joiner (offset map)
+SELECT COUNT(*), SUM(lo_revenue)
+FROM lineorder, part
+WHERE lo_partkey = p_partkey AND p_size < 10;
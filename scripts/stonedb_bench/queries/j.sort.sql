@@ -0,0 +1,4 @@
+-- inequality join: sort joiner
+SELECT COUNT(*)
+FROM dates d1, dates d2
+WHERE d1.d_datekey < d2.d_datekey AND d1.d_year = 1992 AND d2.d_year = 1992;
@@ -0,0 +1,84 @@
+-- Star Schema Benchmark tables for the StoneDB benchmark harness.
+DROP TABLE IF EXISTS lineorder;
+DROP TABLE IF EXISTS customer;
+DROP TABLE IF EXISTS supplier;
+DROP TABLE IF EXISTS part;
+DROP TABLE IF EXISTS dates;
+
+CREATE TABLE customer (
+  c_custkey    INT NOT NULL,
+  c_name       VARCHAR(25) NOT NULL,
+  c_address    VARCHAR(25) NOT NULL,
+  c_city       VARCHAR(10) NOT NULL,
+  c_nation     VARCHAR(15) NOT NULL,
+  c_region     VARCHAR(12) NOT NULL,
+  c_phone      VARCHAR(15) NOT NULL,
+  c_mktsegment VARCHAR(10) NOT NULL,
+  PRIMARY KEY (c_custkey)
+) ENGINE=STONEDB;
+
+CREATE TABLE supplier (
+  s_suppkey INT NOT NULL,
+  s_name    VARCHAR(25) NOT NULL,
+  s_address VARCHAR(25) NOT NULL,
+  s_city    VARCHAR(10) NOT NULL,
+  s_nation  VARCHAR(15) NOT NULL,
+  s_region  VARCHAR(12) NOT NULL,
+  s_phone   VARCHAR(15) NOT NULL,
+  PRIMARY KEY (s_suppkey)
+) ENGINE=STONEDB;
+
+CREATE TABLE part (
+  p_partkey   INT NOT NULL,
+  p_name      VARCHAR(22) NOT NULL,
+  p_mfgr      VARCHAR(6) NOT NULL,
+  p_category  VARCHAR(7) NOT NULL,
+  p_brand1    VARCHAR(9) NOT NULL,
+  p_color     VARCHAR(11) NOT NULL,
+  p_type      VARCHAR(25) NOT NULL,
+  p_size      INT NOT NULL,
+  p_container VARCHAR(10) NOT NULL,
+  PRIMARY KEY (p_partkey)
+) ENGINE=STONEDB;
+
+CREATE TABLE dates (
+  d_datekey          INT NOT NULL,
+  d_date             VARCHAR(18) NOT NULL,
+  d_dayofweek        VARCHAR(9) NOT NULL,
+  d_month            VARCHAR(9) NOT NULL,
+  d_year             INT NOT NULL,
+  d_yearmonthnum     INT NOT NULL,
+  d_yearmonth        VARCHAR(7) NOT NULL,
+  d_daynuminweek     INT NOT NULL,
+  d_daynuminmonth    INT NOT NULL,
+  d_daynuminyear     INT NOT NULL,
+  d_monthnuminyear   INT NOT NULL,
+  d_weeknuminyear    INT NOT NULL,
+  d_sellingseason    VARCHAR(12) NOT NULL,
+  d_lastdayinweekfl  INT NOT NULL,
+  d_lastdayinmonthfl INT NOT NULL,
+  d_holidayfl        INT NOT NULL,
+  d_weekdayfl        INT NOT NULL,
+  PRIMARY KEY (d_datekey)
+) ENGINE=STONEDB;
+
+CREATE TABLE lineorder (
+  lo_orderkey      BIGINT NOT NULL,
+  lo_linenumber    INT NOT NULL,
+  lo_custkey       INT NOT NULL,
+  lo_partkey       INT NOT NULL,
+  lo_suppkey       INT NOT NULL,
+  lo_orderdate     INT NOT NULL,
+  lo_orderpriority VARCHAR(15) NOT NULL,
+  lo_shippriority  INT NOT NULL,
+  lo_quantity      INT NOT NULL,
+  lo_extendedprice INT NOT NULL,
+  lo_ordtotalprice INT NOT NULL,
+  lo_discount      INT NOT NULL,
+  lo_revenue       INT NOT NULL,
+  lo_supplycost    INT NOT NULL,
+  lo_tax           INT NOT NULL,
+  lo_commitdate    INT NOT NULL,
+  lo_shipmode      VARCHAR(10) NOT NULL,
+  PRIMARY KEY (lo_orderkey, lo_linenumber)
+) ENGINE=STONEDB;
@@ -0,0 +1,192 @@
+# Deterministic Star Schema Benchmark data generator.
+#
+# usage: awk -v sf=<scale factor> -v table=<customer|supplier|part|dates|lineorder> -f ssb_gen.awk
+#
+# Writes '|' separated rows to stdout. The output depends only on the scale
+# factor and the table name: every table has its own fixed seed and the
+# generator uses integer arithmetic only, so the same data is produced by
+# any POSIX awk on any machine. Value domains follow the SSB specification
+# closely enough for the standard 13 queries to be selective in the usual way.
+
+function rnd_init(seed) { rnd_state = seed % 2147483647; if (rnd_state <= 0) rnd_state += 2147483646 }
+
+# Park-Miller minimal standard generator; all products fit in 53 bits
+function rnd() { rnd_state = (rnd_state * 16807) % 2147483647; return rnd_state }
+
+# uniform integer from [lo, hi]
+function rnd_range(lo, hi) { return lo + rnd() % (hi - lo + 1) }
+
+function rnd_text(len,    s, i) {
+  s = ""
+  for (i = 0; i < len; i++) s = s substr(alnum, rnd_range(1, length(alnum)), 1)
+  return s
+}
+
+function phone(nation_idx) {
+  return sprintf("%02d-%03d-%03d-%04d", nation_idx + 10, rnd_range(100, 999), rnd_range(100, 999), rnd_range(1000, 9999))
+}
+
+# SSB city: the first 9 characters of the nation (space padded) and a digit
+function city(nation_idx) { return sprintf("%-9.9s%d", nation[nation_idx], rnd_range(0, 9)) }
+
+function is_leap(y) { return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0 }
+
+function init_domains(    i, n) {
+  alnum = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+  n = split("ALGERIA ARGENTINA BRAZIL CANADA EGYPT ETHIOPIA FRANCE GERMANY INDIA INDONESIA IRAN IRAQ JAPAN JORDAN " \
+            "KENYA MOROCCO MOZAMBIQUE PERU CHINA ROMANIA SAUDI_ARABIA VIETNAM RUSSIA UNITED_KINGDOM UNITED_STATES",
+            nation, " ")
+  for (i = 1; i <= n; i++) gsub("_", " ", nation[i])
+  nations = n
+  # region of every nation, as in TPC-H
+  split("1 2 2 2 5 1 4 4 3 3 5 5 3 5 1 1 1 2 3 4 5 3 4 4 2", nation_region, " ")
+  split("AFRICA AMERICA ASIA EUROPE MIDDLE_EAST", region, " ")
+  gsub("_", " ", region[5])
+  segments = split("AUTOMOBILE BUILDING FURNITURE HOUSEHOLD MACHINERY", segment, " ")
+  colors = split("almond antique aquamarine azure beige bisque black blanched blue blush brown burlywood chartreuse " \
+                 "chiffon chocolate coral cornflower cornsilk cream cyan dark deep dim dodger drab firebrick floral " \
+                 "forest frosted gainsboro ghost goldenrod green grey honeydew hot indian ivory khaki lace lavender " \
+                 "lawn lemon light lime linen magenta maroon medium metallic midnight mint misty moccasin navajo navy " \
+                 "olive orange orchid pale papaya peach peru pink plum powder puff purple red rose rosy royal saddle " \
+                 "salmon sandy seashell sienna sky slate smoke snow spring steel tan thistle tomato turquoise violet " \
+                 "wheat white yellow", color, " ")
+  type_s1 = split("STANDARD SMALL MEDIUM LARGE ECONOMY PROMO", type1, " ")
+  type_s2 = split("ANODIZED BURNISHED PLATED POLISHED BRUSHED", type2, " ")
+  type_s3 = split("TIN NICKEL BRASS STEEL COPPER", type3, " ")
+  cont_s1 = split("SM LG MED JUMBO WRAP", cont1, " ")
+  cont_s2 = split("CASE BOX BAG JAR PKG PACK CAN DRUM", cont2, " ")
+  priorities = split("1-URGENT 2-HIGH 3-MEDIUM 4-NOT_SPECI 5-LOW", priority, " ")
+  gsub("_", " ", priority[4])
+  shipmodes = split("REG_AIR AIR RAIL SHIP TRUCK MAIL FOB", shipmode, " ")
+  gsub("_", " ", shipmode[1])
+  split("January February March April May June July August September October November December", month_name, " ")
+  split("Jan Feb Mar Apr May Jun Jul Aug Sep Oct Nov Dec", month_abbr, " ")
+  split("31 28 31 30 31 30 31 31 30 31 30 31", month_days, " ")
+  # 1992-01-01 was a Wednesday
+  split("Wednesday Thursday Friday Saturday Sunday Monday Tuesday", weekday, " ")
+}
+
+# fill datekey[0..ndates-1] with all days of 1992-1998
+function init_dates(    y, m, d, md) {
+  ndates = 0
+  for (y = 1992; y <= 1998; y++)
+    for (m = 1; m <= 12; m++) {
+      md = month_days[m] + (m == 2 && is_leap(y))
+      for (d = 1; d <= md; d++) {
+        date_y[ndates] = y; date_m[ndates] = m; date_d[ndates] = d
+        datekey[ndates++] = y * 10000 + m * 100 + d
+      }
+    }
+}
+
+function gen_customer(    n, i, nat) {
+  rnd_init(1001)
+  n = int(30000 * sf); if (n < 1) n = 1
+  for (i = 1; i <= n; i++) {
+    nat = rnd_range(1, nations)
+    printf "%d|Customer#%09d|%s|%s|%s|%s|%s|%s\n", i, i, rnd_text(rnd_range(10, 25)), city(nat), nation[nat],
+           region[nation_region[nat]], phone(nat), segment[rnd_range(1, segments)]
+  }
+}
+
+function gen_supplier(    n, i, nat) {
+  rnd_init(2002)
+  n = int(2000 * sf); if (n < 1) n = 1
+  for (i = 1; i <= n; i++) {
+    nat = rnd_range(1, nations)
+    printf "%d|Supplier#%09d|%s|%s|%s|%s|%s\n", i, i, rnd_text(rnd_range(10, 25)), city(nat), nation[nat],
+           region[nation_region[nat]], phone(nat)
+  }
+}
+
+function part_count(    n, s) {
+  # 200000 * floor(1 + log2(sf)), scaled down linearly below sf = 1
+  if (sf < 1) { n = int(200000 * sf); return n < 1 ? 1 : n }
+  n = 1
+  for (s = sf; s >= 2; s /= 2) n++
+  return 200000 * n
+}
+
+function gen_part(    n, i, mfgr, cat, brand) {
+  rnd_init(3003)
+  n = part_count()
+  for (i = 1; i <= n; i++) {
+    mfgr = rnd_range(1, 5)
+    cat = rnd_range(1, 5)
+    brand = rnd_range(1, 40)
+    printf "%d|%s %s|MFGR#%d|MFGR#%d%d|MFGR#%d%d%d|%s|%s %s %s|%d|%s %s\n", i, color[rnd_range(1, colors)],
+           color[rnd_range(1, colors)], mfgr, mfgr, cat, mfgr, cat, brand, color[rnd_range(1, colors)],
+           type1[rnd_range(1, type_s1)], type2[rnd_range(1, type_s2)], type3[rnd_range(1, type_s3)],
+           rnd_range(1, 50), cont1[rnd_range(1, cont_s1)], cont2[rnd_range(1, cont_s2)]
+  }
+}
+
+function season(m, d) {
+  if (m == 12 || (m == 11 && d >= 15)) return "Christmas"
+  if (m >= 6 && m <= 8) return "Summer"
+  if (m <= 2) return "Winter"
+  if (m <= 5) return "Spring"
+  return "Fall"
+}
+
+function gen_dates(    i, y, m, d, dow, doy, last_in_month) {
+  doy = 0
+  for (i = 0; i < ndates; i++) {
+    y = date_y[i]; m = date_m[i]; d = date_d[i]
+    doy = (m == 1 && d == 1) ? 1 : doy + 1
+    dow = i % 7  # index into weekday[], 0 = Wednesday
+    last_in_month = (i + 1 == ndates || date_m[i + 1] != m)
+    printf "%d|%s %d, %d|%s|%s|%d|%d|%s%d|%d|%d|%d|%d|%d|%s|%d|%d|%d|%d\n", datekey[i], month_name[m], d, y,
+           weekday[dow + 1], month_name[m], y, y * 100 + m, month_abbr[m], y, (dow + 3) % 7 + 1, d, doy, m,
+           int((doy - 1) / 7) + 1, season(m, d), weekday[dow + 1] == "Saturday", last_in_month,
+           (m == 12 && d == 25) || (m == 1 && d == 1) || (m == 7 && d == 4),
+           weekday[dow + 1] != "Saturday" && weekday[dow + 1] != "Sunday"
+  }
+}
+
+# retail price of a part in cents, as in TPC-H
+function part_price(p) { return 90000 + int(p / 10) % 20001 + 100 * (p % 1000) }
+
+function gen_lineorder(    orders, ncust, nsupp, npart, o, l, lines, cust, od, prio, total, qty, price, disc) {
+  rnd_init(4004)
+  orders = int(1500000 * sf); if (orders < 1) orders = 1
+  ncust = int(30000 * sf); if (ncust < 1) ncust = 1
+  nsupp = int(2000 * sf); if (nsupp < 1) nsupp = 1
+  npart = part_count()
+  for (o = 1; o <= orders; o++) {
+    lines = rnd_range(1, 7)
+    cust = rnd_range(1, ncust)
+    # the last 151 days of 1998 have no orders, like in dbgen
+    od = rnd_range(0, ndates - 152)
+    prio = priority[rnd_range(1, priorities)]
+    total = 0
+    for (l = 1; l <= lines; l++) {
+      lpart[l] = rnd_range(1, npart)
+      lsupp[l] = rnd_range(1, nsupp)
+      qty = rnd_range(1, 50)
+      price = qty * part_price(lpart[l])
+      disc = rnd_range(0, 10)
+      lqty[l] = qty; lprice[l] = price; ldisc[l] = disc
+      ltax[l] = rnd_range(0, 8)
+      lcommit[l] = datekey[od + rnd_range(30, 90)]
+      lmode[l] = shipmode[rnd_range(1, shipmodes)]
+      total += int(int(price * (100 - disc) / 100) * (100 + ltax[l]) / 100)
+    }
+    for (l = 1; l <= lines; l++)
+      printf "%d|%d|%d|%d|%d|%d|%s|0|%d|%d|%d|%d|%d|%d|%d|%d|%s\n", o, l, cust, lpart[l], lsupp[l], datekey[od],
+             prio, lqty[l], lprice[l], total, ldisc[l], int(lprice[l] * (100 - ldisc[l]) / 100),
+             int(6 * part_price(lpart[l]) / 10), ltax[l], lcommit[l], lmode[l]
+  }
+}
+
+BEGIN {
+  if (sf == "" || sf <= 0) { print "ssb_gen.awk: sf must be positive" > "/dev/stderr"; exit 1 }
+  init_domains()
+  init_dates()
+  if (table == "customer") gen_customer()
+  else if (table == "supplier") gen_supplier()
+  else if (table == "part") gen_part()
+  else if (table == "dates") gen_dates()
+  else if (table == "lineorder") gen_lineorder()
+  else { print "ssb_gen.awk: unknown table '" table "'" > "/dev/stderr"; exit 1 }
+}
@@ -0,0 +1,223 @@
+#!/bin/sh
+#
+# Star Schema Benchmark harness for StoneDB.
+#
+# Generates SSB data deterministically, bulk loads it with LOAD DATA, runs the
+# 13 SSB queries and one query per join algorithm cold and warm, and writes a
+# machine-readable report
+# (report.json, plus report.tsv for quick diffs). Two reports can be compared
+# with bench_compare.sh.
+#
+# Everything runs offline: only a running server, the mysql client and awk
+# are needed.
+
+set -e
+
+usage() {
+    cat <<EOF
+usage: $0 [options]
+  -s SF       scale factor, fractions allowed (default: 1)
+  -w DIR      work directory for data files and results (default: ./ssb_work)
+  -D DB       database name (default: ssb)
+  -c "ARGS"   arguments passed to the mysql client, e.g. "-uroot -S /tmp/mysql.sock"
+  -n RUNS     warm runs per query (default: 3)
+  -r "CMD"    command restarting the server; if given, it runs before every cold
+              query, otherwise the cold run is the first run after FLUSH TABLES
+  -q LIST     comma separated queries to run (default: all, e.g. q1.1,q3.2)
+  -k STEPS    comma separated steps: gen,load,query (default: gen,load,query)
+  -o FILE     report file (default: WORKDIR/report.json)
+EOF
+    exit 1
+}
+
+script_dir=`cd \`dirname $0\` && pwd`
+sf=1
+work_dir=`pwd`/ssb_work
+db=ssb
+client_args=""
+runs=3
+restart_cmd=""
+query_list=""
+steps=gen,load,query
+report=""
+
+while getopts "s:w:D:c:n:r:q:k:o:h" opt
+do
+    case $opt in
+        s) sf=$OPTARG ;;
+        w) work_dir=$OPTARG ;;
+        D) db=$OPTARG ;;
+        c) client_args=$OPTARG ;;
+        n) runs=$OPTARG ;;
+        r) restart_cmd=$OPTARG ;;
+        q) query_list=$OPTARG ;;
+        k) steps=$OPTARG ;;
+        o) report=$OPTARG ;;
+        *) usage ;;
+    esac
+done
+
+tables="dates customer supplier part lineorder"
+data_dir=${work_dir}/data_sf${sf}
+result_dir=${work_dir}/results
+[ -n "${report}" ] || report=${work_dir}/report.json
+mkdir -p ${data_dir} ${result_dir}
+
+has_step() {
+    case ",${steps}," in
+        *,$1,*) return 0 ;;
+    esac
+    return 1
+}
+
+sql() {
+    mysql ${client_args} --batch --skip-column-names "$@"
+}
+
+now_ms() {
+    echo $((`date +%s%N` / 1000000))
+}
+
+# print "name value" for all numeric StoneDB status counters
+counters() {
+    sql -e "SHOW GLOBAL STATUS LIKE 'StoneDB\_%'" | awk '$2 ~ /^-?[0-9.]+$/ { print $1, $2 }'
+}
+
+wait_for_server() {
+    i=0
+    until sql -e "SELECT 1" >/dev/null 2>&1
+    do
+        i=$((i + 1))
+        [ $i -lt 120 ] || { echo "server did not come back after restart" >&2; exit 1; }
+        sleep 1
+    done
+}
+
+# ---------------------------------------------------------------------------
+# gen: the data files depend only on SF, so existing ones are reused
+# ---------------------------------------------------------------------------
+if has_step gen
+then
+    for t in ${tables}
+    do
+        if [ ! -f ${data_dir}/$t.tbl ]
+        then
+            echo "generating $t (sf=${sf})"
+            awk -v sf=${sf} -v table=$t -f ${script_dir}/ssb_gen.awk > ${data_dir}/$t.tbl.tmp
+            mv ${data_dir}/$t.tbl.tmp ${data_dir}/$t.tbl
+        fi
+    done
+fi
+
+# ---------------------------------------------------------------------------
+# load
+# ---------------------------------------------------------------------------
+load_json=""
+if has_step load
+then
+    sql -e "CREATE DATABASE IF NOT EXISTS ${db}"
+    sql ${db} < ${script_dir}/schema.sql
+    for t in ${tables}
+    do
+        rows=`wc -l < ${data_dir}/$t.tbl | tr -d ' '`
+        bytes=`wc -c < ${data_dir}/$t.tbl | tr -d ' '`
+        echo "loading $t (${rows} rows)"
+        start=`now_ms`
+        sql --local-infile=1 ${db} -e "LOAD DATA LOCAL INFILE '${data_dir}/$t.tbl' INTO TABLE $t FIELDS TERMINATED BY '|'"
+        ms=$((`now_ms` - start))
+        [ $ms -gt 0 ] || ms=1
+        entry=`awk -v t=$t -v r=$rows -v b=$bytes -v ms=$ms 'BEGIN {
+            printf "{\"table\": \"%s\", \"rows\": %d, \"bytes\": %d, \"ms\": %d, \"rows_per_sec\": %.0f, \"mb_per_sec\": %.2f}",
+                   t, r, b, ms, r * 1000 / ms, b / 1048576 * 1000 / ms }'`
+        load_json="${load_json}${load_json:+, }${entry}"
+    done
+fi
+
+# ---------------------------------------------------------------------------
+# query
+# ---------------------------------------------------------------------------
+query_json=""
+counters_json=""
+: > ${result_dir}/report.tsv.tmp
+if has_step query
+then
+    if [ -z "${query_list}" ]
+    then
+        query_list=`ls ${script_dir}/queries | sed -n 's/\.sql$//p' | tr '\n' ','`
+    fi
+    counters > ${result_dir}/counters.before
+    for q in `echo ${query_list} | tr ',' ' '`
+    do
+        qfile=${script_dir}/queries/$q.sql
+        [ -f ${qfile} ] || { echo "no such query: $q" >&2; exit 1; }
+
+        if [ -n "${restart_cmd}" ]
+        then
+            sh -c "${restart_cmd}" >/dev/null 2>&1
+            wait_for_server
+        else
+            sql -e "FLUSH TABLES"
+        fi
+        start=`now_ms`
+        sql ${db} < ${qfile} > ${result_dir}/$q.out
+        cold=$((`now_ms` - start))
+
+        warm=""
+        i=0
+        while [ $i -lt ${runs} ]
+        do
+            start=`now_ms`
+            sql ${db} < ${qfile} > /dev/null
+            warm="${warm} $((`now_ms` - start))"
+            i=$((i + 1))
+        done
+
+        rows=`wc -l < ${result_dir}/$q.out | tr -d ' '`
+        # the data is deterministic, so is the result: the checksum catches wrong answers
+        checksum=`cksum < ${result_dir}/$q.out | awk '{ print $1 }'`
+        entry=`echo ${warm} | awk -v q=$q -v cold=$cold -v rows=$rows -v ck=$checksum '{
+            n = split($0, w, " ")
+            for (i = 1; i <= n; i++)
+                for (j = i + 1; j <= n; j++)
+                    if (w[j] < w[i]) { t = w[i]; w[i] = w[j]; w[j] = t }
+            med = n ? (n % 2 ? w[(n + 1) / 2] : (w[n / 2] + w[n / 2 + 1]) / 2) : cold
+            list = ""
+            for (i = 1; i <= n; i++) list = list (i > 1 ? ", " : "") w[i]
+            printf "{\"query\": \"%s\", \"cold_ms\": %d, \"warm_ms\": [%s], \"warm_median_ms\": %.1f, \"rows\": %d, \"checksum\": \"%s\"}",
+                   q, cold, list, med, rows, ck
+            printf "%s\t%d\t%.1f\t%s\n", q, cold, med, ck > "/dev/stderr"
+        }' 2>> ${result_dir}/report.tsv.tmp`
+        echo "$q: cold ${cold} ms, warm${warm} ms"
+        query_json="${query_json}${query_json:+,
+    }${entry}"
+    done
+    counters > ${result_dir}/counters.after
+    # counters may be reset by a restart, so the delta is meaningful only without -r
+    counters_json=`awk 'NR == FNR { before[$1] = $2; next }
+        { printf "%s\"%s\": %s", (n++ ? ", " : ""), $1, $2 - before[$1] }' \
+        ${result_dir}/counters.before ${result_dir}/counters.after`
+fi
+
+# ---------------------------------------------------------------------------
+# report
+# ---------------------------------------------------------------------------
+commit=`git -C ${script_dir} rev-parse --short HEAD 2>/dev/null || echo unknown`
+version=`sql -e "SELECT VERSION()" 2>/dev/null || echo unknown`
+cat > ${report} <<EOF
+{
+  "benchmark": "ssb",
+  "scale_factor": ${sf},
+  "commit": "${commit}",
+  "server_version": "${version}",
+  "date": "`date -u +%Y-%m-%dT%H:%M:%SZ`",
+  "warm_runs": ${runs},
+  "cold_mode": "`[ -n "${restart_cmd}" ] && echo restart || echo flush_tables`",
+  "load": [${load_json}],
+  "queries": [
+    ${query_json}
+  ],
+  "counters_delta": {${counters_json}}
+}
+EOF
+mv ${result_dir}/report.tsv.tmp ${report%.json}.tsv
+echo "report written to ${report}"
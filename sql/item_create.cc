@@ -4168,6 +4168,29 @@ protected:
   Create_func_multivalue_find() {}
   virtual ~Create_func_multivalue_find() {}
 };
+
+class Create_func_sdb_window : public Create_native_func
+{
+public:
+  virtual Item *create_native(THD *thd, LEX_STRING name,
+                              PT_item_list *item_list);
+
+  static Create_func_sdb_window s_row_number;
+  static Create_func_sdb_window s_rank;
+  static Create_func_sdb_window s_running_sum;
+  static Create_func_sdb_window s_running_count;
+  static Create_func_sdb_window s_running_avg;
+  static Create_func_sdb_window s_lag;
+  static Create_func_sdb_window s_lead;
+
+protected:
+  explicit Create_func_sdb_window(Item_func_sdb_window::Window_kind kind)
+    : kind(kind) {}
+  virtual ~Create_func_sdb_window() {}
+
+private:
+  Item_func_sdb_window::Window_kind kind;
+};
 #endif
 
 
@@ -4843,6 +4866,39 @@ Create_func_multivalue_find::create(THD *thd, Item *arg1, Item *arg2, Item *arg3
 {
   return new (thd->mem_root) Item_func_multivalue_find(arg1, arg2, arg3);
 }
+
+Create_func_sdb_window
+Create_func_sdb_window::s_row_number(Item_func_sdb_window::ROW_NUMBER);
+Create_func_sdb_window
+Create_func_sdb_window::s_rank(Item_func_sdb_window::RANK);
+Create_func_sdb_window
+Create_func_sdb_window::s_running_sum(Item_func_sdb_window::RUNNING_SUM);
+Create_func_sdb_window
+Create_func_sdb_window::s_running_count(Item_func_sdb_window::RUNNING_COUNT);
+Create_func_sdb_window
+Create_func_sdb_window::s_running_avg(Item_func_sdb_window::RUNNING_AVG);
+Create_func_sdb_window
+Create_func_sdb_window::s_lag(Item_func_sdb_window::LAG);
+Create_func_sdb_window
+Create_func_sdb_window::s_lead(Item_func_sdb_window::LEAD);
+
+Item*
+Create_func_sdb_window::create_native(THD *thd, LEX_STRING name,
+                                      PT_item_list *item_list)
+{
+  uint arg_count= 0;
+
+  if (item_list != NULL)
+    arg_count= item_list->elements();
+
+  if (arg_count < Item_func_sdb_window::leading_arg_count(kind))
+  {
+    my_error(ER_WRONG_PARAMCOUNT_TO_NATIVE_FCT, MYF(0), name.str);
+    return NULL;
+  }
+
+  return new (thd->mem_root) Item_func_sdb_window(POS(), kind, item_list);
+}
 #endif
 
 Create_func_des_decrypt Create_func_des_decrypt::s_singleton;
@@ -7854,6 +7910,13 @@ static Native_func_registry func_array[] =
   { { C_STRING_WITH_LEN("YEARWEEK") }, BUILDER(Create_func_year_week)},
   #ifdef STONEDB
   { { C_STRING_WITH_LEN("MULTIVALUE_FIND") }, BUILDER(Create_func_multivalue_find)},
+  { { C_STRING_WITH_LEN("SDB_LAG") }, &Create_func_sdb_window::s_lag},
+  { { C_STRING_WITH_LEN("SDB_LEAD") }, &Create_func_sdb_window::s_lead},
+  { { C_STRING_WITH_LEN("SDB_RANK") }, &Create_func_sdb_window::s_rank},
+  { { C_STRING_WITH_LEN("SDB_ROW_NUMBER") }, &Create_func_sdb_window::s_row_number},
+  { { C_STRING_WITH_LEN("SDB_RUNNING_AVG") }, &Create_func_sdb_window::s_running_avg},
+  { { C_STRING_WITH_LEN("SDB_RUNNING_COUNT") }, &Create_func_sdb_window::s_running_count},
+  { { C_STRING_WITH_LEN("SDB_RUNNING_SUM") }, &Create_func_sdb_window::s_running_sum},
   #endif
   { {0, 0}, NULL}
 };
@@ -9057,4 +9057,148 @@ longlong Item_func_multivalue_find::val_int()
   }
   return 0;
 }
+
+uint Item_func_sdb_window::leading_arg_count(Window_kind kind)
+{
+  switch (kind) {
+  case ROW_NUMBER:
+    return 0;
+  case LAG:
+  case LEAD:
+    return 2;
+  default:
+    return 1;
+  }
+}
+
+const char *Item_func_sdb_window::func_name() const
+{
+  switch (kind) {
+  case ROW_NUMBER:
+    return "sdb_row_number";
+  case RANK:
+    return "sdb_rank";
+  case RUNNING_SUM:
+    return "sdb_running_sum";
+  case RUNNING_COUNT:
+    return "sdb_running_count";
+  case RUNNING_AVG:
+    return "sdb_running_avg";
+  case LAG:
+    return "sdb_lag";
+  case LEAD:
+    return "sdb_lead";
+  }
+  return "sdb_window";
+}
+
+bool Item_func_sdb_window::fix_fields(THD *thd, Item **ref)
+{
+  if (Item_func::fix_fields(thd, ref))
+    return true;
+  // the offset of LAG/LEAD is a non-negative integer literal
+  if (leading_arg_count() == 2 &&
+      (args[1]->type() != Item::INT_ITEM || args[1]->val_int() < 0))
+  {
+    my_error(ER_WRONG_ARGUMENTS, MYF(0), func_name());
+    return true;
+  }
+  return false;
+}
+
+void Item_func_sdb_window::fix_length_and_dec()
+{
+  hybrid_type= INT_RESULT;
+  hybrid_field_type= MYSQL_TYPE_LONGLONG;
+  decimals= 0;
+  max_length= MY_INT64_NUM_DECIMAL_DIGITS;
+  maybe_null= false;
+  switch (kind) {
+  case ROW_NUMBER:
+  case RANK:
+  case RUNNING_COUNT:
+    break;
+  case RUNNING_SUM:
+    maybe_null= true;
+    if (args[0]->result_type() == INT_RESULT)
+      break;
+    if (args[0]->result_type() == DECIMAL_RESULT)
+    {
+      hybrid_type= DECIMAL_RESULT;
+      hybrid_field_type= MYSQL_TYPE_NEWDECIMAL;
+      decimals= args[0]->decimals;
+      max_length= my_decimal_precision_to_length_no_truncation(
+        args[0]->decimal_precision() + DECIMAL_LONGLONG_DIGITS, decimals,
+        unsigned_flag);
+      break;
+    }
+    hybrid_type= REAL_RESULT;
+    hybrid_field_type= MYSQL_TYPE_DOUBLE;
+    decimals= NOT_FIXED_DEC;
+    max_length= float_length(decimals);
+    break;
+  case RUNNING_AVG:
+    maybe_null= true;
+    hybrid_type= REAL_RESULT;
+    hybrid_field_type= MYSQL_TYPE_DOUBLE;
+    decimals= min<uint>(args[0]->decimals + 4, NOT_FIXED_DEC);
+    max_length= float_length(decimals);
+    break;
+  case LAG:
+  case LEAD:
+    maybe_null= true;
+    hybrid_type= args[0]->result_type();
+    hybrid_field_type= args[0]->field_type();
+    decimals= args[0]->decimals;
+    max_length= args[0]->max_length;
+    unsigned_flag= args[0]->unsigned_flag;
+    collation.set(args[0]->collation);
+    break;
+  }
+}
+
+void Item_func_sdb_window::not_evaluated()
+{
+  char buf[64];
+  my_snprintf(buf, sizeof(buf), "%s() in a query not executed by StoneDB",
+              func_name());
+  my_error(ER_NOT_SUPPORTED_YET, MYF(0), buf);
+  null_value= true;
+}
+
+double Item_func_sdb_window::val_real()
+{
+  not_evaluated();
+  return 0.0;
+}
+
+longlong Item_func_sdb_window::val_int()
+{
+  not_evaluated();
+  return 0;
+}
+
+String *Item_func_sdb_window::val_str(String *)
+{
+  not_evaluated();
+  return NULL;
+}
+
+my_decimal *Item_func_sdb_window::val_decimal(my_decimal *)
+{
+  not_evaluated();
+  return NULL;
+}
+
+bool Item_func_sdb_window::get_date(MYSQL_TIME *, my_time_flags_t)
+{
+  not_evaluated();
+  return true;
+}
+
+bool Item_func_sdb_window::get_time(MYSQL_TIME *)
+{
+  not_evaluated();
+  return true;
+}
 #endif
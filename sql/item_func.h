@@ -2902,5 +2902,63 @@ public:
 private:
   static inline std::set<std::string> sepstr(const std::string &sStr, const std::string &sSep, bool withEmpty);
 };
+
+/*
+  Analytic functions computed by StoneDB on the rows of a query, taken in
+  the order of its ORDER BY clause:
+
+    SDB_ROW_NUMBER([p, ...])          SDB_RANK(v [, p, ...])
+    SDB_RUNNING_SUM(v [, p, ...])     SDB_RUNNING_COUNT(v [, p, ...])
+    SDB_RUNNING_AVG(v [, p, ...])     SDB_LAG(v, n [, p, ...])
+    SDB_LEAD(v, n [, p, ...])
+
+  The trailing arguments p define partitions: a partition is a run of
+  consecutive rows with equal values of p, so the query should be ordered
+  by them first. The running aggregates cover the rows from the start of
+  the partition to the current one, NULL values of v are skipped.
+
+  MySQL cannot evaluate these functions; a query which is not executed by
+  StoneDB fails.
+*/
+class Item_func_sdb_window :public Item_func
+{
+public:
+  enum Window_kind
+  {
+    ROW_NUMBER, RANK, RUNNING_SUM, RUNNING_COUNT, RUNNING_AVG, LAG, LEAD
+  };
+
+  Item_func_sdb_window(const POS &pos, Window_kind kind, PT_item_list *list)
+    :Item_func(pos, list), kind(kind), hybrid_type(INT_RESULT),
+     hybrid_field_type(MYSQL_TYPE_LONGLONG)
+  {}
+  Window_kind window_kind() const { return kind; }
+  /* Number of the arguments preceding the partition columns */
+  static uint leading_arg_count(Window_kind kind);
+  uint leading_arg_count() const { return leading_arg_count(kind); }
+  /* LAG/LEAD: the distance to the row the value is taken from */
+  longlong row_offset() const
+  { return leading_arg_count() == 2 ? args[1]->val_int() : 0; }
+
+  const char *func_name() const;
+  table_map get_initial_pseudo_tables() const { return RAND_TABLE_BIT; }
+  bool fix_fields(THD *thd, Item **ref);
+  void fix_length_and_dec();
+  Item_result result_type() const { return hybrid_type; }
+  enum_field_types field_type() const { return hybrid_field_type; }
+  double val_real();
+  longlong val_int();
+  String *val_str(String *str);
+  my_decimal *val_decimal(my_decimal *decimal_value);
+  bool get_date(MYSQL_TIME *ltime, my_time_flags_t fuzzydate);
+  bool get_time(MYSQL_TIME *ltime);
+
+private:
+  void not_evaluated();
+
+  Window_kind kind;
+  Item_result hybrid_type;
+  enum_field_types hybrid_field_type;
+};
 #endif
 #endif /* ITEM_FUNC_INCLUDED */
@@ -31,6 +31,7 @@ constexpr const char *TABLE_DESC_FILE = "TABLE_DESC";
 constexpr const char *TABLE_VERSION_FILE = "VERSION";
 constexpr const char *TABLE_VERSION_FILE_TMP = "VERSION.tmp";
 constexpr const char *TABLE_VERSION_PREFIX = "V.";
+constexpr const char *TABLE_REBUILD_FILE = "REBUILD";
 
 constexpr uint32_t COL_FILE_MAGIC = 0x004c4f43;  // "COL"
 constexpr const char *COLUMN_DIR = "columns";
@@ -39,6 +40,7 @@ constexpr const char *COL_FILTER_DIR = "filters";
 constexpr const char *COL_FILTER_BLOOM_DIR = "bloom";
 constexpr const char *COL_FILTER_CMAP_DIR = "cmap";
 constexpr const char *COL_FILTER_HIST_DIR = "hist";
+constexpr const char *COL_FILTER_MULTI_DIR = "multi";
 constexpr const char *COL_KN_FILE = "KN";
 constexpr const char *COL_META_FILE = "META";
 constexpr const char *COL_DN_FILE = "DN";
@@ -0,0 +1,144 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+
+#include "spill_codec.h"
+
+#include <cstring>
+#include <type_traits>
+
+#include "common/assert.h"
+#include "compress/lz4.h"
+
+namespace stonedb {
+namespace compress {
+
+size_t SpillCodec::Bound(size_t source_len) {
+  // LZ4 worst case is the largest of all methods; RAW is used if it does not fit
+  return sizeof(Header) + source_len + source_len / 255 + 16;
+}
+
+size_t SpillCodec::StoreRaw(const char *src, size_t len, char *dest) {
+  Header *h = (Header *)dest;
+  h->method = Method::RAW;
+  h->bits = 0;
+  h->raw_len = uint32_t(len);
+  h->data_len = uint32_t(len);
+  h->base = 0;
+  std::memcpy(dest + sizeof(Header), src, len);
+  return sizeof(Header) + len;
+}
+
+template <class T>
+size_t SpillCodec::EncodeInts(const T *src, size_t n, char *dest) {
+  static_assert(std::is_integral<T>::value, "bit packing is for integers only");
+  if (n == 0) return StoreRaw((const char *)src, 0, dest);
+
+  int64_t min = src[0], max = src[0];
+  for (size_t i = 1; i < n; i++) {
+    if (src[i] < min) min = src[i];
+    if (src[i] > max) max = src[i];
+  }
+  uint64_t range = uint64_t(max) - uint64_t(min);
+  uint32_t bits = (range == 0 ? 0 : 64 - __builtin_clzll(range));
+  if (bits >= sizeof(T) * 8) return EncodeBytes((const char *)src, n * sizeof(T), dest);
+
+  size_t words = (n * bits + 63) / 64;
+  Header *h = (Header *)dest;
+  h->method = Method::FOR_BITPACK;
+  h->bits = bits;
+  h->raw_len = uint32_t(n * sizeof(T));
+  h->data_len = uint32_t(words * sizeof(uint64_t));
+  h->base = min;
+
+  uint64_t *out = (uint64_t *)(dest + sizeof(Header));
+  std::memset(out, 0, words * sizeof(uint64_t));
+  if (bits == 0) return sizeof(Header);  // a constant page
+  for (size_t i = 0, pos = 0; i < n; i++, pos += bits) {
+    uint64_t v = uint64_t(int64_t(src[i])) - uint64_t(min);
+    size_t w = pos >> 6;
+    uint32_t off = pos & 63;
+    out[w] |= v << off;
+    if (off + bits > 64) out[w + 1] |= v >> (64 - off);
+  }
+  return sizeof(Header) + h->data_len;
+}
+
+size_t SpillCodec::EncodeBytes(const char *src, size_t len, char *dest) {
+  int comp_len = LZ4_compress_default(src, dest + sizeof(Header), int(len), LZ4_compressBound(int(len)));
+  if (comp_len <= 0 || size_t(comp_len) >= len) return StoreRaw(src, len, dest);
+
+  Header *h = (Header *)dest;
+  h->method = Method::LZ4;
+  h->bits = 0;
+  h->raw_len = uint32_t(len);
+  h->data_len = uint32_t(comp_len);
+  h->base = 0;
+  return sizeof(Header) + comp_len;
+}
+
+template <class T>
+CprsErr SpillCodec::Decode(const char *src, size_t src_len, T *dest, size_t dest_len) {
+  if (src_len < sizeof(Header)) return CprsErr::CPRS_ERR_BUF;
+  const Header *h = (const Header *)src;
+  if (h->raw_len > dest_len || sizeof(Header) + h->data_len > src_len) return CprsErr::CPRS_ERR_BUF;
+  const char *data = src + sizeof(Header);
+
+  switch (h->method) {
+    case Method::RAW:
+      std::memcpy(dest, data, h->raw_len);
+      return CprsErr::CPRS_SUCCESS;
+    case Method::LZ4: {
+      int len = LZ4_decompress_safe(data, (char *)dest, int(h->data_len), int(h->raw_len));
+      return (len == int(h->raw_len) ? CprsErr::CPRS_SUCCESS : CprsErr::CPRS_ERR_COR);
+    }
+    case Method::FOR_BITPACK:
+      if constexpr (std::is_integral<T>::value) {
+        size_t n = h->raw_len / sizeof(T);
+        uint32_t bits = h->bits;
+        if (bits == 0) {
+          for (size_t i = 0; i < n; i++) dest[i] = T(h->base);
+          return CprsErr::CPRS_SUCCESS;
+        }
+        const uint64_t *in = (const uint64_t *)data;
+        uint64_t mask = (bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1);
+        for (size_t i = 0, pos = 0; i < n; i++, pos += bits) {
+          size_t w = pos >> 6;
+          uint32_t off = pos & 63;
+          uint64_t v = in[w] >> off;
+          if (off + bits > 64) v |= in[w + 1] << (64 - off);
+          dest[i] = T(uint64_t(h->base) + (v & mask));
+        }
+        return CprsErr::CPRS_SUCCESS;
+      }
+      break;
+  }
+  return CprsErr::CPRS_ERR_VER;
+}
+
+template size_t SpillCodec::EncodeInts<char>(const char *, size_t, char *);
+template size_t SpillCodec::EncodeInts<short>(const short *, size_t, char *);
+template size_t SpillCodec::EncodeInts<int>(const int *, size_t, char *);
+template size_t SpillCodec::EncodeInts<int64_t>(const int64_t *, size_t, char *);
+
+template CprsErr SpillCodec::Decode<char>(const char *, size_t, char *, size_t);
+template CprsErr SpillCodec::Decode<short>(const char *, size_t, short *, size_t);
+template CprsErr SpillCodec::Decode<int>(const char *, size_t, int *, size_t);
+template CprsErr SpillCodec::Decode<int64_t>(const char *, size_t, int64_t *, size_t);
+template CprsErr SpillCodec::Decode<double>(const char *, size_t, double *, size_t);
+
+}  // namespace compress
+}  // namespace stonedb
@@ -0,0 +1,72 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+#ifndef STONEDB_COMPRESS_SPILL_CODEC_H_
+#define STONEDB_COMPRESS_SPILL_CODEC_H_
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "compress/defs.h"
+
+namespace stonedb {
+namespace compress {
+
+//////////////////////////////////////////////////////////////////////
+//////  Spill Codec (fast compression of intermediate result pages) ////
+// Pages of intermediate results (CachedBuffer) written to the disk cache are
+// read back at most a few times, so the codecs are chosen for speed rather
+// than ratio: frame of reference + bit packing for integers, LZ4 for any other
+// data (doubles, fixed size string slots). If a page does not shrink, it is
+// stored as is.
+//
+// An encoded page starts with a SpillCodec::Header; Encode() needs a
+// destination buffer of at least Bound(source_len) bytes.
+class SpillCodec {
+ public:
+  enum class Method : uint32_t { RAW = 0, FOR_BITPACK = 1, LZ4 = 2 };
+
+  struct Header {
+    Method method;
+    uint32_t bits;      // FOR_BITPACK: bits per value
+    uint32_t raw_len;   // length of the decoded page
+    uint32_t data_len;  // length of the data following the header
+    int64_t base;       // FOR_BITPACK: frame of reference
+  };
+
+  static size_t Bound(size_t source_len);
+
+  // Encode 'n' integers; returns the encoded length (including the header)
+  template <class T>
+  static size_t EncodeInts(const T *src, size_t n, char *dest);
+
+  // Encode 'len' bytes of any content
+  static size_t EncodeBytes(const char *src, size_t len, char *dest);
+
+  // Decode a page produced by EncodeInts<T>() or EncodeBytes() into 'dest' of
+  // 'dest_len' bytes
+  template <class T>
+  static CprsErr Decode(const char *src, size_t src_len, T *dest, size_t dest_len);
+
+ private:
+  static size_t StoreRaw(const char *src, size_t len, char *dest);
+};
+
+}  // namespace compress
+}  // namespace stonedb
+
+#endif  // STONEDB_COMPRESS_SPILL_CODEC_H_
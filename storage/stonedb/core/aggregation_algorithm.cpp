@@ -319,20 +319,12 @@ void AggregationAlgorithm::MultiDimensionalGroupByScan(GroupByWrapper &gbw, int6
       rccontrol.lock(m_conn->GetThreadID()) << "Output rows: " << gbw.NumOfGroups() + gbw.TuplesNoOnes()
                                             << ", output table row limit: " << t->GetPageSize() << system::unlock;
       int64_t output_size = (gbw.NumOfGroups() + gbw.TuplesNoOnes()) * t->GetOneOutputRecordSize();
-      gbw.RewindRows();
-      if (t->GetPageSize() >= (gbw.NumOfGroups() + gbw.TuplesNoOnes()) && output_size > (1L << 29) &&
-          !t->HasHavingConditions() && stonedb_sysvar_parallel_filloutput) {
-        // Turn on parallel output when:
-        // 1. output page is large enough to hold all output rows
-        // 2. output result is larger than 512MB
-        // 3. no have condition
-        rccontrol.lock(m_conn->GetThreadID()) << "Start parallel output" << system::unlock;
-        ParallelFillOutputWrapper(gbw, offset, limit, mit);
-      } else {
-        while (gbw.RowValid()) {
+      auto fill_output = [&](GroupByWrapper &g) {
+        g.RewindRows();
+        while (g.RowValid()) {
           // copy GroupTable into TempTable, row by row
           if (t->NumOfObj() >= limit) break;
-          AggregateFillOutput(gbw, gbw.GetCurrentRow(),
+          AggregateFillOutput(g, g.GetCurrentRow(),
                               offset);  // offset is decremented for each row, if positive
           if (sender && t->NumOfObj() > (1 << mind->ValueOfPower()) - 1) {
             TempTable::RecordIterator iter = t->begin();
@@ -344,8 +336,39 @@ void AggregationAlgorithm::MultiDimensionalGroupByScan(GroupByWrapper &gbw, int6
             limit -= t->NumOfObj();
             t->SetNumOfObj(0);
           }
-          gbw.NextRow();
+          g.NextRow();
         }
+      };
+      gbw.RewindRows();
+      if (!ag_worker.Partitions().empty()) {
+        // the groups were merged by hash partitions (one pass only), each partition is output on its own
+        auto &parts = ag_worker.Partitions();
+        bool any_delayed = false;
+        for (uint i = 0; i < t->NumOfAttrs(); i++)
+          if (t->GetAttrP(i)->mode == common::ColOperation::DELAYED) any_delayed = true;
+        if (t->GetPageSize() >= gbw.NumOfGroups() && limit >= gbw.NumOfGroups() && offset == 0 &&
+            !t->HasHavingConditions() && !any_delayed) {
+          // all rows fit into the output page and no row depends on another one (offset, limit, having) or on
+          // an expression shared by the threads (delayed columns)
+          rccontrol.lock(m_conn->GetThreadID())
+              << "Start parallel output of " << parts.size() << " partitions" << system::unlock;
+          ParallelFillOutputParts(parts, limit);
+        } else {
+          for (auto &part : parts) {
+            if (t->NumOfObj() >= limit) break;
+            fill_output(*part);
+          }
+        }
+      } else if (t->GetPageSize() >= (gbw.NumOfGroups() + gbw.TuplesNoOnes()) && output_size > (1L << 29) &&
+                 !t->HasHavingConditions() && stonedb_sysvar_parallel_filloutput) {
+        // Turn on parallel output when:
+        // 1. output page is large enough to hold all output rows
+        // 2. output result is larger than 512MB
+        // 3. no have condition
+        rccontrol.lock(m_conn->GetThreadID()) << "Start parallel output" << system::unlock;
+        ParallelFillOutputWrapper(gbw, offset, limit, mit);
+      } else {
+        fill_output(gbw);
       }
       if (sender) {
         TempTable::RecordIterator iter = t->begin();
@@ -528,6 +551,11 @@ int AggregationAlgorithm::AggregatePackrow(GroupByWrapper &gbw, MIIterator *mit,
   // so locking will be needed bool require_locking_gr	= (uniform_pos ==
   // common::NULL_VALUE_64);	// do not lock if the grouping row is uniform
 
+  // numerical aggregated values are read for the rest of the packrow when the
+  // first row is aggregated
+  bool values_read = false;
+  int64_t values_row = 0;  // row of the packrow since the values were read
+
   while (mit->IsValid()) {           // becomes invalid on pack end
     if (m_conn->Killed()) return 2;  // killed
     if (gbw.TuplesGet(cur_tuple)) {
@@ -572,15 +600,24 @@ int AggregationAlgorithm::AggregatePackrow(GroupByWrapper &gbw, MIIterator *mit,
             require_locking_ag = false;
           }
 
+          if (!values_read) {
+            gbw.ReadPackValues(*mit);
+            values_read = true;
+            values_row = 0;
+          }
+
           // Prepare packs for aggregated columns
           for (int gr_a = gbw.NumOfGroupingAttrs(); gr_a < gbw.NumOfAttrs(); gr_a++)
             if (gbw.ColumnNotOmitted(gr_a)) {
-              bool value_successfully_aggregated = gbw.PutAggregatedValue(gr_a, pos, *mit, factor);
+              bool value_successfully_aggregated = gbw.PackValueRead(gr_a)
+                                                       ? gbw.PutPackValue(gr_a, pos, values_row, factor)
+                                                       : gbw.PutAggregatedValue(gr_a, pos, *mit, factor);
               if (!value_successfully_aggregated) gbw.DistinctlyOmitted(gr_a, cur_tuple);
             }
         }
       }
     }
+    values_row++;
     cur_tuple++;
     mit->Increment();
     if (mit->PackrowStarted()) break;
@@ -800,6 +837,20 @@ void AggregationAlgorithm::ParallelFillOutputWrapper(GroupByWrapper &gbw, int64_
   res.get_all_with_except();
 }
 
+void AggregationAlgorithm::ParallelFillOutputParts(std::vector<std::unique_ptr<GroupByWrapper>> &parts,
+                                                   int64_t limit) {
+  Transaction *conn = current_tx;
+  utils::result_set<void> res;
+  for (auto &part : parts) {
+    part->RewindRows();
+    res.insert(rceng->query_thread_pool.add_task(&AggregationAlgorithm::TaskFillOutput, this, part.get(), conn,
+                                                 int64_t(0), limit));
+  }
+  res.get_all_with_except();
+  // rows were counted by each attribute concurrently
+  for (uint i = 0; i < t->NumOfAttrs(); i++) t->GetAttrP(i)->SetFilled(t->NumOfObj());
+}
+
 void AggregationAlgorithm::TaskFillOutput(GroupByWrapper *gbw, Transaction *ci, int64_t offset, int64_t limit) {
   common::SetMySQLTHD(ci->Thd());
   current_tx = ci;
@@ -863,6 +914,7 @@ void AggregationWorkerEnt::DistributeAggreTaskAverage(MIIterator &mit) {
 
   int mod = packnum % loopcnt;
   int num = packnum / loopcnt;
+  parts.clear();
   utils::result_set<void> res;
   for (int i = 0; i < loopcnt; ++i) {
     res.insert(rceng->query_thread_pool.add_task(&AggregationWorkerEnt::PrepShardingCopy, this, &mit, gb_main, &vGBW));
@@ -923,10 +975,47 @@ void AggregationWorkerEnt::DistributeAggreTaskAverage(MIIterator &mit) {
   }
   res1.get_all_with_except();
 
-  for (size_t i = 0; i < vTask.size(); ++i) {
-    // Merge aggreation data together
-    if (i != 0) gb_main->Merge(*(vGBW[i]));
+  std::vector<GroupByWrapper *> srcs{gb_main};
+  int64_t no_groups = gb_main->NumOfGroups();
+  for (size_t i = 1; i < vTask.size(); ++i) {
+    srcs.push_back(vGBW[i].get());
+    no_groups += vGBW[i]->NumOfGroups();
+  }
+  // With many groups merging the worker tables one by one into gb_main takes longer than the scan itself. Merge
+  // them by hash partitions in parallel instead, into empty tables sized for a partition of the groups found.
+  if (srcs.size() < 2 || !gb_main->IsOnePass() || no_groups < int64_t(stonedb_sysvar_groupby_parts_min_groups)) {
+    for (size_t i = 1; i < srcs.size(); ++i) {
+      // Merge aggreation data together
+      gb_main->Merge(*srcs[i]);
+    }
+    return;
   }
+  for (size_t i = 0; i < srcs.size(); ++i)
+    parts.emplace_back(new GroupByWrapper(*gb_main, no_groups / int64_t(srcs.size()) + 1));
+
+  if (rccontrol.isOn())
+    rccontrol.lock(conn->GetThreadID()) << "Merging " << no_groups << " groups in " << parts.size() << " partitions"
+                                        << system::unlock;
+  utils::result_set<void> res2;
+  for (size_t i = 0; i < parts.size(); ++i)
+    res2.insert(rceng->query_thread_pool.add_task(&AggregationWorkerEnt::TaskMergePart, this, parts[i].get(), &srcs,
+                                                  int(i), conn));
+  res2.get_all_with_except();
+
+  int64_t merged_groups = 0;
+  for (auto &part : parts) merged_groups += part->NumOfGroups();
+  for (size_t i = 1; i < srcs.size(); ++i) {
+    gb_main->packrows_omitted += srcs[i]->packrows_omitted;
+    gb_main->packrows_part_omitted += srcs[i]->packrows_part_omitted;
+  }
+  gb_main->MovedToParts(merged_groups);
+}
+
+void AggregationWorkerEnt::TaskMergePart(GroupByWrapper *part_gbw, const std::vector<GroupByWrapper *> *srcs,
+                                         int part, Transaction *ci) {
+  common::SetMySQLTHD(ci->Thd());
+  current_tx = ci;
+  part_gbw->MergePart(*srcs, part, int(parts.size()));
 }
 }  // namespace core
 }  // namespace stonedb
@@ -51,6 +51,7 @@ class AggregationAlgorithm {
   }
   void TaskFillOutput(GroupByWrapper *gbw, Transaction *ci, int64_t offset, int64_t limit);
   void ParallelFillOutputWrapper(GroupByWrapper &gbw, int64_t offset, int64_t limit, MIIterator &mit);
+  void ParallelFillOutputParts(std::vector<std::unique_ptr<GroupByWrapper>> &parts, int64_t limit);
   TempTable *GetTempTable() { return t; }
 
  private:
@@ -92,6 +93,10 @@ class AggregationWorkerEnt {
   void DistributeAggreTaskAverage(MIIterator &mit);
   void PrepShardingCopy(MIIterator *mit, GroupByWrapper *gb_sharding,
                         std::vector<std::unique_ptr<GroupByWrapper>> *vGBW);
+  void TaskMergePart(GroupByWrapper *part_gbw, const std::vector<GroupByWrapper *> *srcs, int part, Transaction *ci);
+  // Not empty if the groups of the last parallel pass were merged by hash
+  // partitions: the result is then in these wrappers, not in gb_main
+  std::vector<std::unique_ptr<GroupByWrapper>> &Partitions() { return parts; }
 
  protected:
   GroupByWrapper *gb_main;
@@ -99,6 +104,7 @@ class AggregationWorkerEnt {
   int m_threads;
   AggregationAlgorithm *aa;
   std::mutex mtx;
+  std::vector<std::unique_ptr<GroupByWrapper>> parts;
 };
 }  // namespace core
 }  // namespace stonedb
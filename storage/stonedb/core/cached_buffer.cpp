@@ -17,14 +17,31 @@
 
 #include "cached_buffer.h"
 
+#include <type_traits>
+
+#include "compress/spill_codec.h"
 #include "core/transaction.h"
+#include "system/configuration.h"
 
 namespace stonedb {
 namespace core {
+std::atomic<uint64_t> SpillStat::pages{0};
+std::atomic<uint64_t> SpillStat::raw_bytes{0};
+std::atomic<uint64_t> SpillStat::written_bytes{0};
+
+namespace {
+void CountSpill(size_t raw_bytes, size_t written_bytes) {
+  SpillStat::pages++;
+  SpillStat::raw_bytes += raw_bytes;
+  SpillStat::written_bytes += written_bytes;
+}
+}  // namespace
+
 template <class T>
 CachedBuffer<T>::CachedBuffer(uint page_size, uint _elem_size, Transaction *conn)
     : system::CacheableItem("PS", "CB"), page_size(page_size), elem_size(_elem_size), m_conn(conn) {
   if (!elem_size) elem_size = sizeof(T);
+  compress_pages = stonedb_sysvar_spill_compression && elem_size == sizeof(T);
   CI_SetDefaultSize(page_size * elem_size);
 
   buf = (T *)alloc(sizeof(T) * (size_t)page_size, mm::BLOCK_TYPE::BLOCK_TEMPORARY);
@@ -34,7 +51,11 @@ CachedBuffer<T>::CachedBuffer(uint page_size, uint _elem_size, Transaction *conn
 }
 
 CachedBuffer<types::BString>::CachedBuffer(uint page_size, uint elem_size, Transaction *conn)
-    : system::CacheableItem("PS", "CB"), page_size(page_size), elem_size(elem_size), m_conn(conn) {
+    : system::CacheableItem("PS", "CB"),
+      page_size(page_size),
+      elem_size(elem_size),
+      m_conn(conn),
+      compress_pages(stonedb_sysvar_spill_compression) {
   // DEBUG_ASSERT(elem_size);
   CI_SetDefaultSize(page_size * (elem_size + 4));
 
@@ -51,9 +72,13 @@ CachedBuffer<types::BString>::CachedBuffer(uint page_size, uint elem_size, Trans
 template <class T>
 CachedBuffer<T>::~CachedBuffer() {
   dealloc(buf);
+  if (spill_buf) dealloc(spill_buf);
 }
 
-CachedBuffer<types::BString>::~CachedBuffer() { dealloc(buf); }
+CachedBuffer<types::BString>::~CachedBuffer() {
+  dealloc(buf);
+  if (spill_buf) dealloc(spill_buf);
+}
 
 template <class T>
 T &CachedBuffer<T>::Get(uint64_t idx) {
@@ -83,7 +108,7 @@ template <class T>
 void CachedBuffer<T>::Set(uint64_t idx, const T &value) {
   if (idx / page_size != loaded_page) LoadPage((uint)(idx / page_size));
   buf[idx % page_size] = value;
-  page_changed = true;
+  if (!page_changed.load(std::memory_order_relaxed)) page_changed.store(true, std::memory_order_relaxed);
 }
 
 void CachedBuffer<types::BString>::Set(uint64_t idx, const types::BString &value) {
@@ -97,7 +122,26 @@ void CachedBuffer<types::BString>::Set(uint64_t idx, const types::BString &value
     *size = value.len;
     std::memcpy(&buf[pos + 4], value.val, value.len);
   }
-  page_changed = true;
+  if (!page_changed.load(std::memory_order_relaxed)) page_changed.store(true, std::memory_order_relaxed);
+}
+
+template <class T>
+void CachedBuffer<T>::SavePage() {
+  size_t raw_size = (size_t)page_size * elem_size;
+  if (!compress_pages) {
+    CI_Put(loaded_page, (unsigned char *)buf);
+    CountSpill(raw_size, raw_size);
+    return;
+  }
+  if (!spill_buf)
+    spill_buf = (char *)alloc(compress::SpillCodec::Bound(raw_size), mm::BLOCK_TYPE::BLOCK_TEMPORARY);
+  size_t size;
+  if constexpr (std::is_integral<T>::value)
+    size = compress::SpillCodec::EncodeInts(buf, page_size, spill_buf);
+  else
+    size = compress::SpillCodec::EncodeBytes((char *)buf, raw_size, spill_buf);
+  CI_Put(loaded_page, (unsigned char *)spill_buf, int(size));
+  CountSpill(raw_size, size);
 }
 
 template <class T>
@@ -106,24 +150,53 @@ void CachedBuffer<T>::LoadPage(uint page) {
     throw common::KilledException();  // cleaning is implemented below (we are
                                       // inside try{})
   if (page_changed) {                 // Save current page
-    CI_Put(loaded_page, (unsigned char *)buf);
+    SavePage();
     page_changed = false;
   }
   // load new page to memory
-  CI_Get(page, (unsigned char *)buf);
+  if (!compress_pages) {
+    CI_Get(page, (unsigned char *)buf);
+  } else if (spill_buf && CI_Get(page, (unsigned char *)spill_buf) == 0) {
+    size_t raw_size = (size_t)page_size * elem_size;
+    if (compress::SpillCodec::Decode(spill_buf, compress::SpillCodec::Bound(raw_size), buf, raw_size) !=
+        CprsErr::CPRS_SUCCESS)
+      throw common::DatabaseException("Corrupted page of intermediate results in the disk cache.");
+  }
   loaded_page = page;
 }
 
+void CachedBuffer<types::BString>::SavePage() {
+  size_t raw_size = (size_t)page_size * (elem_size + 4);
+  if (!compress_pages) {
+    CI_Put(loaded_page, (unsigned char *)buf);
+    CountSpill(raw_size, raw_size);
+    return;
+  }
+  if (!spill_buf)
+    spill_buf = (char *)alloc(compress::SpillCodec::Bound(raw_size), mm::BLOCK_TYPE::BLOCK_TEMPORARY);
+  // the slots are padded to elem_size, LZ4 removes the padding and repeated values
+  size_t size = compress::SpillCodec::EncodeBytes(buf, raw_size, spill_buf);
+  CI_Put(loaded_page, (unsigned char *)spill_buf, int(size));
+  CountSpill(raw_size, size);
+}
+
 void CachedBuffer<types::BString>::LoadPage(uint page) {
   if (m_conn && m_conn->Killed())
     throw common::KilledException();  // cleaning is implemented below (we are
                                       // inside try{})
   if (page_changed) {                 // Save current page
-    CI_Put(loaded_page, (unsigned char *)buf);
+    SavePage();
     page_changed = false;
   }
   // load new page to memory
-  CI_Get(page, (unsigned char *)buf);
+  if (!compress_pages) {
+    CI_Get(page, (unsigned char *)buf);
+  } else if (spill_buf && CI_Get(page, (unsigned char *)spill_buf) == 0) {
+    size_t raw_size = (size_t)page_size * (elem_size + 4);
+    if (compress::SpillCodec::Decode(spill_buf, compress::SpillCodec::Bound(raw_size), buf, raw_size) !=
+        CprsErr::CPRS_SUCCESS)
+      throw common::DatabaseException("Corrupted page of intermediate results in the disk cache.");
+  }
   loaded_page = page;
 }
 
@@ -136,6 +209,9 @@ void CachedBuffer<T>::SetNewPageSize(uint new_page_size) {
   page_size = new_page_size;
   CI_SetDefaultSize(page_size * elem_size);
   buf = (T *)rc_realloc(buf, sizeof(T) * (size_t)page_size, mm::BLOCK_TYPE::BLOCK_TEMPORARY);
+  if (spill_buf)
+    spill_buf = (char *)rc_realloc(spill_buf, compress::SpillCodec::Bound((size_t)page_size * elem_size),
+                                   mm::BLOCK_TYPE::BLOCK_TEMPORARY);
 }
 
 void CachedBuffer<types::BString>::SetNewPageSize(uint new_page_size) {
@@ -147,6 +223,8 @@ void CachedBuffer<types::BString>::SetNewPageSize(uint new_page_size) {
   CI_SetDefaultSize(page_size * (elem_size + 4));
   size_t buf_size = (size_t)page_size * (elem_size + 4) * sizeof(char);
   buf = (char *)rc_realloc(buf, buf_size, mm::BLOCK_TYPE::BLOCK_TEMPORARY);
+  if (spill_buf)
+    spill_buf = (char *)rc_realloc(spill_buf, compress::SpillCodec::Bound(buf_size), mm::BLOCK_TYPE::BLOCK_TEMPORARY);
 }
 
 template class CachedBuffer<short>;
@@ -18,6 +18,8 @@
 #define STONEDB_CORE_CACHED_BUFFER_H_
 #pragma once
 
+#include <atomic>
+
 #include "common/common_definitions.h"
 #include "mm/traceable_object.h"
 #include "system/cacheable_item.h"
@@ -31,10 +33,19 @@ built-in type in an array. One page of elements is kept in memory (2^25 = 33 554
 432). If there are more elements they are cached on a disk (class
 CacheableItem). Methods Get and Set are to read/write a value. NOTE: it is not
 suitable to store structures containing pointers.
+Pages are compressed (compress::SpillCodec) before being written to disk,
+unless stonedb_spill_compression is off.
 */
 
 class Transaction;
 
+// totals over all CachedBuffer pages written to the disk cache
+struct SpillStat {
+  static std::atomic<uint64_t> pages;
+  static std::atomic<uint64_t> raw_bytes;      // size of the pages before compression
+  static std::atomic<uint64_t> written_bytes;  // size actually written
+};
+
 template <class T>
 class CachedBuffer : public system::CacheableItem, public mm::TraceableObject {
  public:
@@ -53,13 +64,18 @@ class CachedBuffer : public system::CacheableItem, public mm::TraceableObject {
 
  protected:
   void LoadPage(uint n);     // load page n
+  void SavePage();           // write the loaded page to disk
   unsigned int loaded_page;  // number of page loaded to memory?
-  bool page_changed;         // is current page changed and has to be saved?
+  // is current page changed and has to be saved? Set by concurrent Set() on a
+  // resident page, see TempTable::Attr::FillRange()
+  std::atomic_bool page_changed;
   uint page_size;            // size of one page stored in memory (number of elements)
   uint elem_size;            // size of one element in BYTES; for most types computed by
                              // sizeof()
   T *buf;
   Transaction *m_conn;
+  bool compress_pages;        // pages on disk are encoded by compress::SpillCodec
+  char *spill_buf = nullptr;  // encoded page, allocated on the first spill
 };
 
 /* buffers, in the case of BString, keep the char * only. first 4 bytes define
@@ -84,14 +100,19 @@ class CachedBuffer<types::BString> : public system::CacheableItem, public mm::Tr
 
  protected:
   void LoadPage(uint n);     // load page n
+  void SavePage();           // write the loaded page to disk
   unsigned int loaded_page;  // number of page loaded to memory?
-  bool page_changed;         // is current page changed and has to be saved?
+  // is current page changed and has to be saved? Set by concurrent Set() on a
+  // resident page, see TempTable::Attr::FillRange()
+  std::atomic_bool page_changed;
   uint page_size;            // size of one page stored in memory (number of elements)
   uint elem_size;            // size of one element in BYTES; for most types computed by
                              // sizeof()
   char *buf;
   types::BString bufS;
   Transaction *m_conn;
+  bool compress_pages;        // pages on disk are encoded by compress::SpillCodec
+  char *spill_buf = nullptr;  // encoded page, allocated on the first spill
 };
 }  // namespace core
 }  // namespace stonedb
@@ -16,6 +16,9 @@
 */
 
 #include "column_bin_encoder.h"
+
+#include <typeinfo>
+
 #include "core/bin_tools.h"
 #include "core/mi_iterator.h"
 #include "core/transaction.h"
@@ -23,9 +26,22 @@
 
 namespace stonedb {
 namespace core {
+namespace {
+template <typename T>
+void AppendRaw(std::string &fp, const T &v) {
+  fp.append(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+
+// Shorter strings are cheaper as fixed size collation keys than as dictionary ids
+const uint INTERNED_MIN_STRING_SIZE = 32;
+const size_t INTERNED_BLOCK_SIZE = 1 << 20;
+const size_t INTERNED_CACHE_SIZE = 4096;  // entries of the per copy id cache
+}  // namespace
+
 ColumnBinEncoder::ColumnBinEncoder(int flags) {
   ignore_nulls = ((flags & ENCODER_IGNORE_NULLS) != 0);
   monotonic_encoding = ((flags & ENCODER_MONOTONIC) != 0);
+  interned = ((flags & ENCODER_INTERNED) != 0);
   noncomparable = ((flags & ENCODER_NONCOMPARABLE) != 0);
   descending = ((flags & ENCODER_DESCENDING) != 0);
   decodable = ((flags & ENCODER_DECODABLE) != 0);
@@ -44,6 +60,7 @@ ColumnBinEncoder::ColumnBinEncoder(const ColumnBinEncoder &sec) {
   implicit = sec.implicit;
   ignore_nulls = sec.ignore_nulls;
   monotonic_encoding = sec.monotonic_encoding;
+  interned = sec.interned;
   noncomparable = sec.noncomparable;
   descending = sec.descending;
   decodable = sec.decodable;
@@ -64,6 +81,7 @@ ColumnBinEncoder &ColumnBinEncoder::operator=(const ColumnBinEncoder &sec) {
   if (&sec != this) {
     ignore_nulls = sec.ignore_nulls;
     monotonic_encoding = sec.monotonic_encoding;
+    interned = sec.interned;
     noncomparable = sec.noncomparable;
     descending = sec.descending;
     decodable = sec.decodable;
@@ -119,8 +137,11 @@ bool ColumnBinEncoder::PrepareEncoder(vcolumn::VirtualColumn *_vc, vcolumn::Virt
       DTCollation col_v2 = _vc2->GetCollation();
       coll = types::ResolveCollation(col_v1, col_v2);
     }
-    if (!noncomparable)  // noncomparable => non-sorted cols in sorter, don't
-                         // UTF-encode.
+    if (!noncomparable && interned && !monotonic_encoding && _vc2 == NULL &&
+        vc->MaxStringSize() > INTERNED_MIN_STRING_SIZE)  // fixed size keys would be too wide
+      my_encoder.reset(new ColumnBinEncoder::EncoderTextInterned(vc, decodable, nulls_possible, descending));
+    else if (!noncomparable)  // noncomparable => non-sorted cols in sorter, don't
+                              // UTF-encode.
       my_encoder.reset(new ColumnBinEncoder::EncoderText_UTF(vc, decodable, nulls_possible, descending));
     else {
       my_encoder.reset(new ColumnBinEncoder::EncoderTextStat(vc, decodable, nulls_possible, descending));
@@ -249,6 +270,19 @@ int64_t ColumnBinEncoder::MaxCode()  // Maximal integer code, if it makes any
   return my_encoder->MaxCode();
 }
 
+bool ColumnBinEncoder::GetFingerprint(std::string &fp) const {
+  if (!my_encoder) return false;
+  AppendRaw(fp, ignore_nulls);
+  AppendRaw(fp, monotonic_encoding);
+  AppendRaw(fp, descending);
+  AppendRaw(fp, noncomparable);
+  AppendRaw(fp, val_offset);
+  AppendRaw(fp, val_sec_offset);
+  AppendRaw(fp, val_size);
+  AppendRaw(fp, val_sec_size);
+  return my_encoder->Fingerprint(fp);
+}
+
 void ColumnBinEncoder::LoadPacks(MIIterator *mit) {
   if (IsEnabled() && IsNontrivial() && dup_col == -1)  // constant num. columns are trivial
     LockSourcePacks(*mit);
@@ -278,6 +312,21 @@ ColumnBinEncoder::EncoderInt::EncoderInt(vcolumn::VirtualColumn *vc, bool decoda
   max_found = common::MINUS_INF_64;
 }
 
+void ColumnBinEncoder::ColumnValueEncoder::CommonFingerprint(std::string &fp) const {
+  fp += typeid(*this).name();
+  AppendRaw(fp, descending);
+  AppendRaw(fp, null_status);
+  AppendRaw(fp, size);
+  AppendRaw(fp, size_sec);
+}
+
+bool ColumnBinEncoder::EncoderInt::Fingerprint(std::string &fp) const {
+  CommonFingerprint(fp);
+  AppendRaw(fp, min_val);
+  AppendRaw(fp, max_code);
+  return true;
+}
+
 bool ColumnBinEncoder::EncoderInt::SecondColumn(vcolumn::VirtualColumn *vc) {
   if (!vc->Type().IsFixed() && !(this->vc_type.IsDateTime() && vc->Type().IsDateTime())) {
     rccontrol.lock(vc->ConnInfo()->GetThreadID())
@@ -456,6 +505,14 @@ ColumnBinEncoder::EncoderDecimal::EncoderDecimal(vcolumn::VirtualColumn *vc, boo
   size_sec = 0;
 }
 
+bool ColumnBinEncoder::EncoderDecimal::Fingerprint(std::string &fp) const {
+  EncoderInt::Fingerprint(fp);
+  AppendRaw(fp, scale);
+  AppendRaw(fp, multiplier);
+  AppendRaw(fp, sec_multiplier);
+  return true;
+}
+
 bool ColumnBinEncoder::EncoderDecimal::SecondColumn(vcolumn::VirtualColumn *vc) {
   int64_t max_val = max_code + min_val - (null_status == 1 ? 1 : 0);
   int64_t new_min_val = vc->RoughMin();
@@ -699,6 +756,13 @@ ColumnBinEncoder::EncoderDouble::EncoderDouble(vcolumn::VirtualColumn *vc, bool
   }
 }
 
+bool ColumnBinEncoder::EncoderDouble::Fingerprint(std::string &fp) const {
+  CommonFingerprint(fp);
+  AppendRaw(fp, multiplier_vc1);
+  AppendRaw(fp, multiplier_vc2);
+  return true;
+}
+
 bool ColumnBinEncoder::EncoderDouble::SecondColumn(vcolumn::VirtualColumn *vc) {
   // Possible conversions: all numericals.
   if (!vc->Type().IsFixed() && !vc->Type().IsFloat()) {
@@ -808,6 +872,11 @@ ColumnBinEncoder::EncoderText::EncoderText(vcolumn::VirtualColumn *vc, bool deco
 
 ColumnBinEncoder::EncoderText::~EncoderText() {}
 
+bool ColumnBinEncoder::EncoderText::Fingerprint(std::string &fp) const {
+  CommonFingerprint(fp);
+  return true;
+}
+
 bool ColumnBinEncoder::EncoderText::SecondColumn(vcolumn::VirtualColumn *vc) {
   size = std::max(size,
                   vc->MaxStringSize() + sizeof(uint32_t));  // 4 bytes for len
@@ -907,6 +976,12 @@ ColumnBinEncoder::EncoderText_UTF::EncoderText_UTF(vcolumn::VirtualColumn *vc, b
 
 ColumnBinEncoder::EncoderText_UTF::~EncoderText_UTF() {}
 
+bool ColumnBinEncoder::EncoderText_UTF::Fingerprint(std::string &fp) const {
+  CommonFingerprint(fp);
+  AppendRaw(fp, collation.collation->number);
+  return true;
+}
+
 bool ColumnBinEncoder::EncoderText_UTF::SecondColumn(vcolumn::VirtualColumn *vc2) {
   if (vc_type.IsString() && vc2->Type().IsString() && collation.collation != vc2->GetCollation().collation) {
     rccontrol.lock(vc2->ConnInfo()->GetThreadID()) << "Nontrivial comparison: " << collation.collation->name << " with "
@@ -1295,6 +1370,140 @@ bool ColumnBinEncoder::EncoderTextMD5::ImpossibleStringValues(types::BString &pa
   return false;
 }
 
+ColumnBinEncoder::EncoderTextInterned::EncoderTextInterned(vcolumn::VirtualColumn *vc, bool decodable,
+                                                           bool nulls_possible, bool _descending)
+    : ColumnValueEncoder(vc, decodable, nulls_possible, _descending), min_max_set(false) {
+  collation = vc->GetCollation();
+  dict = std::make_shared<Dictionary>();
+  size = sizeof(uint32_t);  // ids are not ordered, so descending is meaningless
+  size_sec = 0;             // values are decoded from the dictionary
+  null_status = (nulls_possible ? 1 : 0);
+}
+
+void ColumnBinEncoder::EncoderTextInterned::UpdateMinMax(types::BString &s) {
+  if (!min_max_set) {
+    maxs.PersistentCopy(s);
+    mins.PersistentCopy(s);
+    min_max_set = true;
+  } else {
+    if (CollationStrCmp(collation, s, maxs) > 0) maxs.PersistentCopy(s);
+    if (CollationStrCmp(collation, s, mins) < 0) mins.PersistentCopy(s);
+  }
+}
+
+void ColumnBinEncoder::EncoderTextInterned::Encode(uchar *buf, uchar *buf_sec, vcolumn::VirtualColumn *vc,
+                                                   MIIterator &mit, bool update_stats) {
+  if (null_status > 0 && vc->IsNull(mit)) {
+    SetNull(buf, buf_sec);
+    return;
+  }
+  types::BString s;
+  vc->GetNotNullValueString(s, mit);
+  if (update_stats) UpdateMinMax(s);
+  uint32_t id = Intern(s.GetDataBytesPointer(), s.len);
+  std::memcpy(buf, &id, sizeof(uint32_t));
+}
+
+bool ColumnBinEncoder::EncoderTextInterned::EncodeString(uchar *buf, uchar *buf_sec, types::BString &s,
+                                                         [[maybe_unused]] bool sec_column, bool update_stats) {
+  if (null_status > 0 && s.IsNull()) {
+    SetNull(buf, buf_sec);
+    return true;
+  }
+  if (update_stats) UpdateMinMax(s);
+  uint32_t id = Intern(s.GetDataBytesPointer(), s.len);
+  std::memcpy(buf, &id, sizeof(uint32_t));
+  return true;
+}
+
+void ColumnBinEncoder::EncoderTextInterned::SetNull(uchar *buf, [[maybe_unused]] uchar *buf_sec) {
+  std::memset(buf, 0, size);
+}
+
+bool ColumnBinEncoder::EncoderTextInterned::IsNull(uchar *buf, [[maybe_unused]] uchar *buf_sec) {
+  return (*(reinterpret_cast<uint32_t *>(buf)) == 0);
+}
+
+types::BString ColumnBinEncoder::EncoderTextInterned::GetValueT(uchar *buf, uchar *buf_sec) {
+  if (IsNull(buf, buf_sec)) return types::BString();
+  return dict->Value(*(reinterpret_cast<uint32_t *>(buf)));
+}
+
+bool ColumnBinEncoder::EncoderTextInterned::ImpossibleStringValues(types::BString &pack_min,
+                                                                   types::BString &pack_max) {
+  unsigned char min[8] = {};
+  unsigned char max[8] = {};
+  std::memcpy(min, pack_min.val, pack_min.len);
+  std::memcpy(max, pack_max.val, pack_max.len);
+  if (!maxs.GreaterEqThanMinUTF(min, collation) || !mins.LessEqThanMaxUTF(max, collation)) return true;
+  return false;
+}
+
+uint32_t ColumnBinEncoder::EncoderTextInterned::Intern(const char *val, uint len) {
+  // the key is <len+1><collation key>, i.e. the same equality as EncoderText_UTF
+  key_buf.assign(sizeof(uint32_t) + types::CollationBufLen(collation, len), '\0');
+  uint32_t length = len + 1;
+  std::memcpy(&key_buf[0], &length, sizeof(uint32_t));
+  common::strnxfrm(collation, (uchar *)&key_buf[sizeof(uint32_t)], key_buf.size() - sizeof(uint32_t),
+                   (const uchar *)val, len);
+  std::string_view key(key_buf);
+  if (id_cache.empty()) id_cache.resize(INTERNED_CACHE_SIZE);
+  auto &cached = id_cache[std::hash<std::string_view>()(key) % INTERNED_CACHE_SIZE];
+  if (cached.id != 0 && cached.key == key) return cached.id;  // no need to lock the dictionary
+  cached.id = dict->Intern(key, val, len, cached.key);
+  return cached.id;
+}
+
+ColumnBinEncoder::EncoderTextInterned::Dictionary::~Dictionary() {
+  for (auto b : blocks) dealloc(b);
+}
+
+uint32_t ColumnBinEncoder::EncoderTextInterned::Dictionary::Intern(std::string_view key, const char *val, uint len,
+                                                                   std::string_view &stored_key) {
+  {
+    std::shared_lock<std::shared_mutex> guard(mtx);
+    auto it = ids.find(key);
+    if (it != ids.end()) {
+      stored_key = it->first;
+      return it->second;
+    }
+  }
+  std::unique_lock<std::shared_mutex> guard(mtx);
+  auto it = ids.find(key);
+  if (it != ids.end()) {  // added by another thread in the meantime
+    stored_key = it->first;
+    return it->second;
+  }
+  DEBUG_ASSERT(values.size() < UINT32_MAX - 1);
+  stored_key = std::string_view(Store(key.data(), key.size()), key.size());
+  values.emplace_back(Store(val, len), len);
+  uint32_t id = uint32_t(values.size());
+  ids.emplace(stored_key, id);
+  return id;
+}
+
+types::BString ColumnBinEncoder::EncoderTextInterned::Dictionary::Value(uint32_t id) {
+  std::shared_lock<std::shared_mutex> guard(mtx);
+  DEBUG_ASSERT(id > 0 && id <= values.size());
+  std::string_view v = values[id - 1];
+  if (v.size() == 0) return types::BString("");
+  return types::BString(v.data(), v.size(), false);  // stored values never move
+}
+
+const char *ColumnBinEncoder::EncoderTextInterned::Dictionary::Store(const char *val, size_t len) {
+  if (len > block_free) {
+    size_t block_size = std::max(len, INTERNED_BLOCK_SIZE);
+    blocks.push_back(static_cast<char *>(alloc(block_size, mm::BLOCK_TYPE::BLOCK_TEMPORARY)));
+    block_pos = blocks.back();
+    block_free = block_size;
+  }
+  char *res = block_pos;
+  if (len > 0) std::memcpy(res, val, len);
+  block_pos += len;
+  block_free -= len;
+  return res;
+}
+
 MultiindexPositionEncoder::MultiindexPositionEncoder(MultiIndex *mind, DimensionVector &dims) {
   val_size = 0;
   val_offset = 0;
@@ -18,7 +18,14 @@
 #define STONEDB_CORE_COLUMN_BIN_ENCODER_H_
 #pragma once
 
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 #include "core/rsi_cmap.h"
+#include "mm/traceable_object.h"
 #include "types/text_stat.h"
 #include "vc/virtual_column.h"
 
@@ -36,6 +43,8 @@ class ColumnBinEncoder final {
                                                   // transformations not applied)
   static const int ENCODER_DESCENDING = 0x08;     // ordering direction
   static const int ENCODER_DECODABLE = 0x10;      // GetValue works
+  static const int ENCODER_INTERNED = 0x20;       // long strings may be encoded as ids of a dictionary built
+                                                  // on the fly (non-monotonic, one column only)
 
   class ColumnValueEncoder;
   // Special cases:
@@ -49,6 +58,7 @@ class ColumnBinEncoder final {
   class EncoderLookup;
   class EncoderTextStat;
   class EncoderTextMD5;
+  class EncoderTextInterned;
 
   ColumnBinEncoder(int flags = 0);
   ColumnBinEncoder(const ColumnBinEncoder &sec);
@@ -71,6 +81,7 @@ class ColumnBinEncoder final {
     disabled = true;
   }  // implicit: the column will be read as vc->GetValue(iterator) instead of
      // orig. values
+  bool IsImplicit() const { return implicit; }
 
   // Buffer descriptions
   uint GetPrimarySize()  // no. of bytes in the primary buffer
@@ -133,11 +144,20 @@ class ColumnBinEncoder final {
   bool DefineAsEquivalent(ColumnBinEncoder const &sec) { return (vc == sec.vc); }
   void SetDupCol(int col) { dup_col = col; }
 
+  // Append a description of the encoding (encoder type, layout and parameters)
+  // to 'fp'. Encoders with equal fingerprints produce equal codes for equal
+  // values. Return false if the codes depend on anything else (e.g. a
+  // translation table of two dictionaries).
+  bool GetFingerprint(std::string &fp) const;
+  // Rebind the encoder to another (equivalent) column, or detach it (NULL)
+  void SetColumn(vcolumn::VirtualColumn *_vc) { vc = _vc; }
+
  private:
   vcolumn::VirtualColumn *vc;
 
   bool ignore_nulls;
   bool monotonic_encoding;
+  bool interned;
   bool descending;
   bool decodable;
   bool noncomparable;
@@ -222,6 +242,7 @@ class ColumnBinEncoder::ColumnValueEncoder {  // base class for detailed
   virtual void ClearStatistics() {}
   virtual bool IsString() { return false; }
   virtual int64_t MaxCode() { return common::NULL_VALUE_64; }
+  virtual bool Fingerprint([[maybe_unused]] std::string &fp) const { return false; }
   size_t ValueSize() { return size; }
   size_t ValueSizeSec() { return size_sec; }
 
@@ -236,6 +257,7 @@ class ColumnBinEncoder::ColumnValueEncoder {  // base class for detailed
   void Negate(unsigned char *buf, int loc_size) {
     for (int i = 0; i < loc_size; i++) buf[i] = ~(buf[i]);
   }
+  void CommonFingerprint(std::string &fp) const;
 };
 
 class ColumnBinEncoder::EncoderInt : public ColumnBinEncoder::ColumnValueEncoder {
@@ -259,6 +281,7 @@ class ColumnBinEncoder::EncoderInt : public ColumnBinEncoder::ColumnValueEncoder
   int64_t GetValue64(unsigned char *buf, unsigned char *buf_sec) override;
   int64_t MaxCode() override { return max_code; }
   void UpdateStatistics(unsigned char *buf) override;
+  bool Fingerprint(std::string &fp) const override;
 
   int64_t ValEncode(vcolumn::VirtualColumn *vc, MIIterator &mit, bool update_stats = false) override;
   int64_t ValEncodeInt64(int64_t v, bool update_stats) override;
@@ -281,6 +304,7 @@ class ColumnBinEncoder::EncoderDecimal : public ColumnBinEncoder::EncoderInt {
       : EncoderInt(sec), scale(sec.scale), multiplier(sec.multiplier), sec_multiplier(sec.sec_multiplier) {}
   ColumnValueEncoder *Copy() override { return new EncoderDecimal(*this); }
   bool SecondColumn(vcolumn::VirtualColumn *vc) override;
+  bool Fingerprint(std::string &fp) const override;
   void Encode(unsigned char *buf, unsigned char *buf_sec, vcolumn::VirtualColumn *vc, MIIterator &mit,
               bool update_stats = false) override;
   bool EncodeInt64(unsigned char *buf, unsigned char *buf_sec, int64_t v, bool sec_column, bool update_stats) override;
@@ -334,6 +358,7 @@ class ColumnBinEncoder::EncoderDouble : public ColumnBinEncoder::ColumnValueEnco
       : ColumnValueEncoder(sec), multiplier_vc1(sec.multiplier_vc1), multiplier_vc2(sec.multiplier_vc2) {}
   ColumnValueEncoder *Copy() override { return new EncoderDouble(*this); }
   bool SecondColumn(vcolumn::VirtualColumn *vc) override;
+  bool Fingerprint(std::string &fp) const override;
 
   bool EncodeInt64(unsigned char *buf, unsigned char *buf_sec, int64_t v, bool sec_column, bool update_stats) override;
   void Encode(unsigned char *buf, unsigned char *buf_sec, vcolumn::VirtualColumn *vc, MIIterator &mit,
@@ -357,6 +382,7 @@ class ColumnBinEncoder::EncoderText : public ColumnBinEncoder::ColumnValueEncode
       : ColumnValueEncoder(sec), mins(sec.mins), maxs(sec.maxs), min_max_set(sec.min_max_set) {}
   ColumnValueEncoder *Copy() override { return new EncoderText(*this); }
   bool SecondColumn(vcolumn::VirtualColumn *vc) override;
+  bool Fingerprint(std::string &fp) const override;
 
   // Encoding:
   // <comparable text><len+1>,   text is padded with zeros
@@ -385,6 +411,7 @@ class ColumnBinEncoder::EncoderText_UTF : public ColumnBinEncoder::ColumnValueEn
         min_max_set(sec.min_max_set) {}
   ColumnValueEncoder *Copy() override { return new EncoderText_UTF(*this); }
   bool SecondColumn(vcolumn::VirtualColumn *vc) override;
+  bool Fingerprint(std::string &fp) const override;
 
   // Encoding:
   // <comparable text><len+1>,   text is padded with zeros
@@ -411,6 +438,7 @@ class ColumnBinEncoder::EncoderLookup : public ColumnBinEncoder::EncoderInt {
   virtual ~EncoderLookup();
   ColumnValueEncoder *Copy() override { return new EncoderLookup(*this); }
   bool SecondColumn(vcolumn::VirtualColumn *vc) override;
+  bool Fingerprint([[maybe_unused]] std::string &fp) const override { return false; }  // depends on both dictionaries
   void Encode(unsigned char *buf, unsigned char *buf_sec, vcolumn::VirtualColumn *vc, MIIterator &mit,
               bool update_stats = false) override;
   bool EncodeInt64(unsigned char *buf, unsigned char *buf_sec, int64_t v, bool sec_column, bool update_stats) override;
@@ -438,6 +466,7 @@ class ColumnBinEncoder::EncoderTextStat : public ColumnBinEncoder::EncoderInt {
   ColumnValueEncoder *Copy() override { return new EncoderTextStat(*this); }
   bool Valid() override { return valid; }
   bool SecondColumn(vcolumn::VirtualColumn *vc) override;
+  bool Fingerprint([[maybe_unused]] std::string &fp) const override { return false; }  // depends on the statistics
   void Encode(unsigned char *buf, unsigned char *buf_sec, vcolumn::VirtualColumn *vc, MIIterator &mit,
               bool update_stats = false) override;
   bool EncodeString(uchar *buf, uchar *buf_sec, types::BString &s, bool sec_column, bool update_stats) override;
@@ -476,6 +505,74 @@ class ColumnBinEncoder::EncoderTextMD5 : public ColumnBinEncoder::ColumnValueEnc
   char empty_buf[HASH_FUNCTION_BYTE_SIZE];
 };
 
+class ColumnBinEncoder::EncoderTextInterned : public ColumnBinEncoder::ColumnValueEncoder {
+ public:
+  EncoderTextInterned(vcolumn::VirtualColumn *vc, bool decodable, bool nulls_possible, bool _descending);
+  EncoderTextInterned(const EncoderTextInterned &sec)
+      : ColumnValueEncoder(sec),
+        collation(sec.collation),
+        dict(sec.dict),
+        mins(sec.mins),
+        maxs(sec.maxs),
+        min_max_set(sec.min_max_set) {}
+  ColumnValueEncoder *Copy() override { return new EncoderTextInterned(*this); }
+  bool Fingerprint([[maybe_unused]] std::string &fp) const override { return false; }  // depends on the dictionary
+
+  // Encoding:
+  // <id>, 4 bytes. 0 is null, other ids are positions in a dictionary of
+  // collation keys (with length), shared by all copies of the encoder. The
+  // first value seen for a key is kept for decoding. Ids are given in the
+  // order of the first occurrence, not of the values: the group tables are
+  // hashed, and sorting uses the order preserving encoders.
+  void Encode(uchar *buf, uchar *buf_sec, vcolumn::VirtualColumn *vc, MIIterator &mit,
+              bool update_stats = false) override;
+  bool EncodeString(uchar *buf, uchar *buf_sec, types::BString &s, bool sec_column, bool update_stats) override;
+  void SetNull(unsigned char *buf, unsigned char *buf_sec) override;
+  bool IsNull(unsigned char *buf, unsigned char *buf_sec) override;
+  types::BString GetValueT(unsigned char *buf, unsigned char *buf_sec) override;
+  bool ImpossibleStringValues(types::BString &pack_min, types::BString &pack_max) override;
+  bool IsString() override { return true; }
+
+ private:
+  // keys and values are kept in blocks allocated through the memory manager
+  class Dictionary : public mm::TraceableObject {
+   public:
+    Dictionary() = default;
+    ~Dictionary();
+    // thread safe; 'stored_key' is set to the copy of 'key' kept as long as the dictionary
+    uint32_t Intern(std::string_view key, const char *val, uint len, std::string_view &stored_key);
+    types::BString Value(uint32_t id);
+
+    mm::TO_TYPE TraceableType() const override { return mm::TO_TYPE::TO_TEMPORARY; }
+
+   private:
+    const char *Store(const char *val, size_t len);
+
+    std::shared_mutex mtx;
+    std::vector<char *> blocks;
+    char *block_pos = nullptr;
+    size_t block_free = 0;
+    std::unordered_map<std::string_view, uint32_t> ids;  // collation key -> id
+    std::vector<std::string_view> values;                // values[id - 1]
+  };
+
+  // an entry of the cache of the last ids found by this copy of the encoder
+  struct CachedId {
+    std::string_view key;  // points into the dictionary
+    uint32_t id = 0;
+  };
+
+  void UpdateMinMax(types::BString &s);
+  uint32_t Intern(const char *val, uint len);  // through the cache, then the dictionary
+
+  DTCollation collation;
+  std::shared_ptr<Dictionary> dict;
+  std::vector<CachedId> id_cache;  // not copied, each worker has its own copy of the encoder
+  std::string key_buf;             // the collation key of the last value
+  types::BString mins, maxs;
+  bool min_max_set;
+};
+
 class MultiindexPositionEncoder {
  public:
   MultiindexPositionEncoder(MultiIndex *mind, DimensionVector &dims);
@@ -17,6 +17,7 @@
 
 #include <sys/mman.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cstring>
 
 #include "common/exception.h"
@@ -116,8 +117,9 @@ void ColumnShare::scan_dpn(common::TX_ID xid) {
   ASSERT(hdr.np <= cap, "bad dpn index");
 
   if (hdr.np == 0) {
-    for (uint32_t i = 0; i < cap; i++) {
-      start[i].reset();
+    for (uint32_t i = cap; i > 0; i--) {
+      start[i - 1].reset();
+      free_dpns.push_back(i - 1);
     }
     return;
   }
@@ -130,6 +132,7 @@ void ColumnShare::scan_dpn(common::TX_ID xid) {
     auto found = std::find(arr.get(), end, i);
     if (found == end) {
       start[i].reset();
+      free_dpns.push_back(i);
     } else {
       start[i].SetPackPtr(0);
       start[i].used = 1;
@@ -147,6 +150,7 @@ void ColumnShare::scan_dpn(common::TX_ID xid) {
     }
   }
 
+  std::reverse(free_dpns.begin(), free_dpns.end());
   segs.sort([](const auto &a, const auto &b) { return a.offset < b.offset; });
 
   // make sure the data is good
@@ -200,32 +204,63 @@ static_assert(ALLOC_UNIT % sizeof(DPN) == 0);
 static constexpr size_t DPN_INC_CNT = ALLOC_UNIT / sizeof(DPN);
 
 int ColumnShare::alloc_dpn(common::TX_ID xid, const DPN *from) {
-  for (uint32_t i = 0; i < cap; i++) {
-    if (start[i].used == 1) {
-      if (!(start[i].xmax < rceng->MinXID())) continue;
-      rceng->cache.DropObject(PackCoordinate(owner->TabID(), col_id, i));
+  reclaim_dpns();
+
+  std::scoped_lock guard(dpn_mtx);
+  if (free_dpns.empty()) {
+    ASSERT((cap + DPN_INC_CNT) <= (common::COL_DN_FILE_SIZE / sizeof(DPN)),
+           "Failed to allocate new DN: " + m_path.string());
+    cap += DPN_INC_CNT;
+
+    //  NOTICE:
+    // It is not portable to enlarge the file size after mmapping, but it seems to
+    // work well on Linux. Otherwise we'll need to remmap the file, which in turn
+    // requires locking because other threads may read simultaneously.
+    ftruncate(dn_fd, cap * sizeof(DPN));
+    for (size_t i = cap; i > cap - DPN_INC_CNT; i--) free_dpns.push_back(i - 1);
+  }
+
+  auto i = free_dpns.back();
+  free_dpns.pop_back();
+  init_dpn(start[i], xid, from);
+  return i;
+}
+
+void ColumnShare::retire_dpn(common::PACK_INDEX i, common::TX_ID epoch) {
+  std::scoped_lock guard(dpn_mtx);
+  start[i].xmax = epoch;
+  retired.emplace_back(epoch, i);
+}
+
+void ColumnShare::free_dpn(common::PACK_INDEX i) {
+  std::scoped_lock guard(dpn_mtx);
+  free_dpns.push_back(i);
+}
+
+void ColumnShare::reclaim_dpns() {
+  std::scoped_lock guard(dpn_mtx);
+  auto min_xid = rceng->MinXID();
+  for (auto it = retired.begin(); it != retired.end();) {
+    if (!(it->first < min_xid)) {
+      ++it;
+      continue;
+    }
+    auto i = it->second;
+    rceng->cache.DropObject(PackCoordinate(owner->TabID(), col_id, i));
+    {
+      std::scoped_lock seg_guard(segs_mtx);
       segs.remove_if([i](const auto &s) { return s.idx == i; });
     }
-    init_dpn(start[i], xid, from);
-    return i;
+    start[i].reset();
+    free_dpns.push_back(i);
+    it = retired.erase(it);
   }
-
-  ASSERT((cap + DPN_INC_CNT) <= (common::COL_DN_FILE_SIZE / sizeof(DPN)),
-         "Failed to allocate new DN: " + m_path.string());
-  cap += DPN_INC_CNT;
-
-  //  NOTICE:
-  // It is not portable to enlarge the file size after mmapping, but it seems to
-  // work well on Linux. Otherwise we'll need to remmap the file, which in turn
-  // requires locking because other threads may read simultaneously.
-  ftruncate(dn_fd, cap * sizeof(DPN));
-  init_dpn(start[cap - 1], xid, from);
-  return cap - 1;
 }
 
 void ColumnShare::alloc_seg(DPN *dpn) {
   auto i = GetPackIndex(dpn);
 
+  std::scoped_lock guard(segs_mtx);
   uint64_t prev = 0;
   for (auto it = segs.cbegin(); it != segs.cend(); ++it) {
     if (it->offset - prev > dpn->len) {
@@ -19,6 +19,9 @@
 #pragma once
 
 #include <list>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "common/assert.h"
 #include "common/common_definitions.h"
@@ -84,6 +87,13 @@ class ColumnShare final {
 
   int alloc_dpn(common::TX_ID xid, const DPN *dpn = nullptr);
   void init_dpn(DPN &dpn, const common::TX_ID xid, const DPN *from);
+  // DPN 'i' was replaced by a committed write; it may be reused as soon as
+  // there is no transaction older than 'epoch' (the max trx id at the commit)
+  void retire_dpn(common::PACK_INDEX i, common::TX_ID epoch);
+  // DPN 'i' of a rolled back write is free again
+  void free_dpn(common::PACK_INDEX i);
+  // release the retired DPNs (and their cached packs) no snapshot can see any more
+  void reclaim_dpns();
   void sync_dpns();
   void alloc_seg(DPN *dpn);
 
@@ -116,7 +126,15 @@ class ColumnShare final {
     uint64_t len;
     common::PACK_INDEX idx;
   };
-  std::list<seg> segs;  // only used by write session so no mutex is needed
+  // only used by the write session, but packs of one column may be saved
+  // concurrently while loading
+  std::list<seg> segs;
+  std::mutex segs_mtx;
+
+  // retired DPNs with their epochs, and unused DPNs (the lowest index last)
+  std::list<std::pair<common::TX_ID, common::PACK_INDEX>> retired;
+  std::vector<common::PACK_INDEX> free_dpns;
+  std::mutex dpn_mtx;
 
   bool has_filter_cmap = false;
   bool has_filter_hist = false;
@@ -19,6 +19,7 @@
 #include "core/compiled_query.h"
 #include "core/engine.h"
 #include "core/mysql_expression.h"
+#include "core/transaction.h"
 #include "core/value_set.h"
 
 namespace stonedb {
@@ -121,10 +122,12 @@ int OperationUnmysterify(Item *item, common::ColOperation &oper, bool &distinct,
           oper = common::ColOperation::GROUP_CONCAT;
           break;
         default:
+          current_tx->SetFallbackReason("unsupported aggregate function");
           return RETURN_QUERY_TO_MYSQL_ROUTE;
       }
       break;
     default:
+      current_tx->SetFallbackReason("unsupported item type");
       return RETURN_QUERY_TO_MYSQL_ROUTE;
   }
   return RCBASE_QUERY_ROUTE;
@@ -411,6 +411,10 @@ void CompiledQuery::CQStep::Print(Query *query) {
     case StepType::ADD_ORDER:
       std::sprintf(buf, "T:%d.ADD_ORDER(VC:%d.%d,%s)", N(t1.n), N(t1.n), N(a1.n), n1 ? "DESC" : "ASC");
       break;
+    case StepType::ADD_WINDOW:
+      std::sprintf(buf, "T:%d.ADD_WINDOW(A:%d,%ld,A:%d,%ld,%ld partition columns)", N(t1.n), N(a1.n), n1, N(a2.n), n2,
+                   virt_cols.size());
+      break;
     case StepType::UNION:
       std::sprintf(buf, "T:%d = UNION(T:%d,T:%d,%ld)", N(t1.n), N(t2.n), N(t3.n), n1);
       break;
@@ -675,6 +679,19 @@ void CompiledQuery::Add_Order(const TabID &t1, const AttrID &vc,
   steps.push_back(s);
 }
 
+void CompiledQuery::AddWindow(const TabID &t1, const AttrID &a1, int kind, int64_t offset, const AttrID &arg,
+                              const std::vector<int> &partition) {
+  CompiledQuery::CQStep s;
+  s.type = StepType::ADD_WINDOW;
+  s.t1 = t1;
+  s.a1 = a1;
+  s.a2 = arg;
+  s.n1 = kind;
+  s.n2 = offset;
+  s.virt_cols = partition;
+  steps.push_back(s);
+}
+
 void CompiledQuery::Union(TabID &t_out, const TabID &t2, const TabID &t3, int all) {
   CompiledQuery::CQStep s;
   s.type = StepType::UNION;
@@ -726,6 +743,8 @@ bool CompiledQuery::NoAggregationOrderingAndDistinct(int table) {
       return false;  // exclude all kinds of aggregations
     if (step.type == CompiledQuery::StepType::T_MODE && step.t1.n == table && step.tmpar == TMParameter::TM_DISTINCT)
       return false;  // exclude DISTINCT
+    if (step.type == CompiledQuery::StepType::ADD_WINDOW && step.t1.n == table)
+      return false;  // analytic functions need all rows
   }
   return true;
 }
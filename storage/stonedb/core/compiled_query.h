@@ -55,7 +55,8 @@ class CompiledQuery final {
     UNION,
     RESULT,
     STEP_ERROR,
-    CREATE_VC
+    CREATE_VC,
+    ADD_WINDOW
   };
 
   class CQStep {
@@ -178,6 +179,14 @@ class CompiledQuery final {
     int a_c(static_cast<int>(p_c));
     if (p_c == a_c) this->Add_Order(p_t, AttrID(-abs(a_c)), a_c < 0);
   }
+  /*! \brief Create compilation step ADD_WINDOW: the column a1 of t1 is
+   * computed by an analytic function after t1 is materialized \param kind -
+   * Item_func_sdb_window::Window_kind \param offset - distance of LAG/LEAD
+   * \param arg - column of the function argument, if any \param partition -
+   * columns defining partitions
+   */
+  void AddWindow(const TabID &t1, const AttrID &a1, int kind, int64_t offset, const AttrID &arg,
+                 const std::vector<int> &partition);
   void Union(TabID &t_out, const TabID &t2, const TabID &t3, int all = 0);
   void Result(const TabID &t1);
 
@@ -0,0 +1,429 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+
+#include "datetime_kernel.h"
+
+#include <cstring>
+
+#include "core/item_sdbfield.h"
+#include "core/rc_attr_typeinfo.h"
+#include "item_timefunc.h"
+#include "sql_time.h"
+
+namespace stonedb {
+namespace core {
+namespace {
+// lowest bit of each DT field, see types::DT
+constexpr int kSecondShift = 20;
+constexpr int kMinuteShift = 26;
+constexpr int kHourShift = 32;
+constexpr int kDayShift = 37;
+constexpr int kMonthShift = 42;
+constexpr int kYearShift = 46;
+constexpr int kNoParent = 64;
+
+constexpr int64_t kSecondsPerDay = 86400;
+constexpr int kMinSupportedYear = 1000;
+constexpr int kMaxSupportedYear = 9999;
+
+bool IsSdbField(Item *item) { return item->type() == Item_sdbfield::get_sdbitem_type(); }
+
+bool ZeroInDate(const types::DT &dt) { return dt.month == 0 || dt.day == 0; }
+
+// Bits which have to be equal in the pack min and max so that a field of DT
+// is monotonic between them. kNoParent means that the function is monotonic
+// on the whole domain.
+int ParentShift(DateTimeKernel::Function f) {
+  switch (f) {
+    case DateTimeKernel::Function::QUARTER:
+    case DateTimeKernel::Function::MONTH:
+      return kYearShift;
+    case DateTimeKernel::Function::DAYOFMONTH:
+      return kMonthShift;
+    case DateTimeKernel::Function::HOUR:
+      return kDayShift;
+    case DateTimeKernel::Function::MINUTE:
+      return kHourShift;
+    case DateTimeKernel::Function::SECOND:
+      return kMinuteShift;
+    default:
+      return kNoParent;
+  }
+}
+
+// the whole range of an extracted field, used when min and max differ on
+// the parent fields
+int64_t FieldUpperBound(DateTimeKernel::Function f) {
+  switch (f) {
+    case DateTimeKernel::Function::QUARTER:
+      return 4;
+    case DateTimeKernel::Function::MONTH:
+      return 12;
+    case DateTimeKernel::Function::DAYOFMONTH:
+      return 31;
+    case DateTimeKernel::Function::HOUR:
+      return 23;
+    case DateTimeKernel::Function::MINUTE:
+    case DateTimeKernel::Function::SECOND:
+      return 59;
+    default:
+      return common::PLUS_INF_64;
+  }
+}
+
+bool FormatSupported(const std::string &fmt) {
+  for (size_t i = 0; i < fmt.size(); i++) {
+    if (fmt[i] != '%') continue;
+    if (++i == fmt.size()) return false;
+    if (std::strchr("YymcdeHkisSfT%", fmt[i]) == nullptr) return false;
+  }
+  return true;
+}
+
+void AppendNumber(std::string &out, unsigned v, int width) {
+  char buf[16];
+  int len = std::snprintf(buf, sizeof(buf), "%0*u", width, v);
+  out.append(buf, len);
+}
+}  // namespace
+
+std::shared_ptr<DateTimeKernel> DateTimeKernel::Create(Item *item, common::CT arg_type, common::CT res_type) {
+  // TIMESTAMP values are kept in UTC and converted to the session time zone by
+  // Item_sdbfield, so only zone-independent types are handled natively
+  if (arg_type != common::CT::DATE && arg_type != common::CT::DATETIME) return nullptr;
+  if (item->type() != Item::FUNC_ITEM) return nullptr;
+  Item_func *ifunc = static_cast<Item_func *>(item);
+  if (ifunc->arg_count == 0 || !IsSdbField(ifunc->arguments()[0])) return nullptr;
+  const char *name = ifunc->func_name();
+
+  std::shared_ptr<DateTimeKernel> kernel;
+  auto make = [&](Function f) {
+    kernel = std::shared_ptr<DateTimeKernel>(new DateTimeKernel(f, arg_type, res_type));
+  };
+
+  if (ifunc->arg_count == 1 && ATI::IsIntegerType(res_type)) {
+    if (std::strcmp(name, "year") == 0)
+      make(Function::YEAR);
+    else if (std::strcmp(name, "quarter") == 0)
+      make(Function::QUARTER);
+    else if (std::strcmp(name, "month") == 0)
+      make(Function::MONTH);
+    else if (std::strcmp(name, "dayofmonth") == 0)
+      make(Function::DAYOFMONTH);
+    else if (std::strcmp(name, "hour") == 0)
+      make(Function::HOUR);
+    else if (std::strcmp(name, "minute") == 0)
+      make(Function::MINUTE);
+    else if (std::strcmp(name, "second") == 0)
+      make(Function::SECOND);
+    else if (std::strcmp(name, "to_days") == 0)
+      make(Function::TO_DAYS);
+    else if (Item_extract *ie = dynamic_cast<Item_extract *>(ifunc)) {
+      switch (ie->int_type) {
+        case INTERVAL_YEAR:
+          make(Function::YEAR);
+          break;
+        case INTERVAL_QUARTER:
+          make(Function::QUARTER);
+          break;
+        case INTERVAL_MONTH:
+          make(Function::MONTH);
+          break;
+        case INTERVAL_DAY:
+          make(Function::DAYOFMONTH);
+          break;
+        case INTERVAL_HOUR:
+          make(Function::HOUR);
+          break;
+        case INTERVAL_MINUTE:
+          make(Function::MINUTE);
+          break;
+        case INTERVAL_SECOND:
+          make(Function::SECOND);
+          break;
+        case INTERVAL_YEAR_MONTH:
+          make(Function::YEAR_MONTH);
+          break;
+        default:
+          break;
+      }
+    }
+    return kernel;
+  }
+
+  if (ifunc->arg_count == 1 && res_type == common::CT::DATE && dynamic_cast<Item_date_typecast *>(ifunc)) {
+    make(Function::DATE);
+    return kernel;
+  }
+
+  if (ifunc->arg_count == 2 && (res_type == common::CT::DATE || res_type == common::CT::DATETIME)) {
+    Item_date_add_interval *ia = dynamic_cast<Item_date_add_interval *>(ifunc);
+    Item *arg = ifunc->arguments()[1];
+    if (ia == nullptr || !arg->const_item() || arg->result_type() != INT_RESULT) return nullptr;
+    int64_t value = arg->val_int();
+    // anything beyond the supported year range will never produce a valid date
+    const int64_t max_interval = int64_t(kMaxSupportedYear + 1) * 366 * kSecondsPerDay;
+    if (arg->null_value || value > max_interval || value < -max_interval) return nullptr;
+    if (ia->date_sub_interval) value = -value;
+    bool months = false;
+    switch (ia->int_type) {
+      case INTERVAL_YEAR:
+        value *= 12;
+        months = true;
+        break;
+      case INTERVAL_QUARTER:
+        value *= 3;
+        months = true;
+        break;
+      case INTERVAL_MONTH:
+        months = true;
+        break;
+      case INTERVAL_WEEK:
+        value *= 7 * kSecondsPerDay;
+        break;
+      case INTERVAL_DAY:
+        value *= kSecondsPerDay;
+        break;
+      case INTERVAL_HOUR:
+        value *= 3600;
+        break;
+      case INTERVAL_MINUTE:
+        value *= 60;
+        break;
+      case INTERVAL_SECOND:
+        break;
+      default:
+        return nullptr;
+    }
+    if (value > max_interval || value < -max_interval) return nullptr;
+    make(Function::ADD_INTERVAL);
+    kernel->interval_in_months = months;
+    kernel->interval = value;
+    return kernel;
+  }
+
+  if (ifunc->arg_count == 2 && ATI::IsStringType(res_type) && std::strcmp(name, "date_format") == 0) {
+    Item *arg = ifunc->arguments()[1];
+    if (!arg->const_item()) return nullptr;
+    String buf;
+    String *fmt = arg->val_str(&buf);
+    if (fmt == nullptr || arg->null_value) return nullptr;
+    std::string f(fmt->ptr(), fmt->length());
+    if (!FormatSupported(f)) return nullptr;
+    make(Function::DATE_FORMAT);
+    kernel->format = f;
+    return kernel;
+  }
+  return nullptr;
+}
+
+bool DateTimeKernel::AddInterval(const types::DT &in, types::DT &out) const {
+  uint year = in.year, month = in.month, day = in.day;
+  int64_t time_of_day = 0;
+  if (interval_in_months) {
+    int64_t period = int64_t(year) * 12 + month - 1 + interval;
+    if (period < 0) return false;
+    year = uint(period / 12);
+    month = uint(period % 12) + 1;
+    uint last_day = types::RCDateTime::NoDaysInMonth(year, month);
+    if (day > last_day) day = last_day;
+    time_of_day = int64_t(in.hour) * 3600 + in.minute * 60 + in.second;
+  } else {
+    int64_t sec = int64_t(calc_daynr(year, month, day)) * kSecondsPerDay + int64_t(in.hour) * 3600 + in.minute * 60 +
+                  in.second + interval;
+    if (sec < 0) return false;
+    get_date_from_daynr(long(sec / kSecondsPerDay), &year, &month, &day);
+    time_of_day = sec % kSecondsPerDay;
+  }
+  if (year < kMinSupportedYear || year > kMaxSupportedYear) return false;
+
+  out.val = 0;
+  out.year = year;
+  out.month = month;
+  out.day = day;
+  if (res_type == common::CT::DATETIME) {
+    out.hour = time_of_day / 3600;
+    out.minute = (time_of_day / 60) % 60;
+    out.second = time_of_day % 60;
+    out.microsecond = in.microsecond;
+  }
+  return true;
+}
+
+bool DateTimeKernel::Apply(int64_t arg, int64_t &res) const {
+  if (arg == common::NULL_VALUE_64) {
+    res = common::NULL_VALUE_64;
+    return true;
+  }
+  types::DT dt;
+  dt.val = arg;
+  switch (func) {
+    case Function::YEAR:
+      res = dt.year;
+      return true;
+    case Function::QUARTER:
+      res = (dt.month + 2) / 3;
+      return true;
+    case Function::MONTH:
+      res = dt.month;
+      return true;
+    case Function::DAYOFMONTH:
+      res = dt.day;
+      return true;
+    case Function::HOUR:
+      res = dt.hour;
+      return true;
+    case Function::MINUTE:
+      res = dt.minute;
+      return true;
+    case Function::SECOND:
+      res = dt.second;
+      return true;
+    case Function::YEAR_MONTH:
+      res = int64_t(dt.year) * 100 + dt.month;
+      return true;
+    case Function::TO_DAYS:
+      if (ZeroInDate(dt)) return false;
+      res = calc_daynr(dt.year, dt.month, dt.day);
+      return true;
+    case Function::DATE: {
+      if (ZeroInDate(dt)) return false;
+      types::DT out;
+      out.val = 0;  // no time part
+      out.year = dt.year;
+      out.month = dt.month;
+      out.day = dt.day;
+      res = out.val;
+      return true;
+    }
+    case Function::ADD_INTERVAL: {
+      types::DT out;
+      if (ZeroInDate(dt) || !AddInterval(dt, out)) return false;
+      res = out.val;
+      return true;
+    }
+    case Function::DATE_FORMAT:
+      if (ZeroInDate(dt)) return false;
+      res = arg;
+      return true;
+  }
+  return false;
+}
+
+void DateTimeKernel::Apply(const int64_t *in, int64_t *out, size_t n, int64_t fallback_mark) const {
+  switch (func) {
+    // the simple extractions never fall back, let the compiler vectorize them
+    case Function::YEAR:
+      for (size_t i = 0; i < n; i++)
+        out[i] = (in[i] == common::NULL_VALUE_64 ? common::NULL_VALUE_64 : (in[i] >> kYearShift) & 0x3FFF);
+      break;
+    case Function::MONTH:
+      for (size_t i = 0; i < n; i++)
+        out[i] = (in[i] == common::NULL_VALUE_64 ? common::NULL_VALUE_64 : (in[i] >> kMonthShift) & 0xF);
+      break;
+    case Function::DAYOFMONTH:
+      for (size_t i = 0; i < n; i++)
+        out[i] = (in[i] == common::NULL_VALUE_64 ? common::NULL_VALUE_64 : (in[i] >> kDayShift) & 0x1F);
+      break;
+    default:
+      for (size_t i = 0; i < n; i++)
+        if (!Apply(in[i], out[i])) out[i] = fallback_mark;
+      break;
+  }
+}
+
+bool DateTimeKernel::RoughRange(int64_t arg_min, int64_t arg_max, int64_t &res_min, int64_t &res_max) const {
+  if (StringResult() || arg_min == common::NULL_VALUE_64 || arg_max == common::NULL_VALUE_64 ||
+      arg_min == common::MINUS_INF_64 || arg_max == common::PLUS_INF_64 || arg_min > arg_max)
+    return false;
+  int parent = ParentShift(func);
+  if (parent != kNoParent && (uint64_t(arg_min) >> parent) != (uint64_t(arg_max) >> parent)) {
+    res_min = 0;
+    res_max = FieldUpperBound(func);
+    return true;
+  }
+  // monotonic on [arg_min, arg_max]
+  return Apply(arg_min, res_min) && Apply(arg_max, res_max) && res_min != common::NULL_VALUE_64 &&
+         res_max != common::NULL_VALUE_64;
+}
+
+void DateTimeKernel::Format(int64_t arg, types::BString &s) const {
+  if (arg == common::NULL_VALUE_64) {
+    s = types::BString();
+    return;
+  }
+  types::DT dt;
+  dt.val = arg;
+  std::string out;
+  out.reserve(format.size() * 2);
+  for (size_t i = 0; i < format.size(); i++) {
+    if (format[i] != '%') {
+      out.push_back(format[i]);
+      continue;
+    }
+    switch (format[++i]) {
+      case 'Y':
+        AppendNumber(out, dt.year, 4);
+        break;
+      case 'y':
+        AppendNumber(out, dt.year % 100, 2);
+        break;
+      case 'm':
+        AppendNumber(out, dt.month, 2);
+        break;
+      case 'c':
+        AppendNumber(out, dt.month, 1);
+        break;
+      case 'd':
+        AppendNumber(out, dt.day, 2);
+        break;
+      case 'e':
+        AppendNumber(out, dt.day, 1);
+        break;
+      case 'H':
+        AppendNumber(out, dt.hour, 2);
+        break;
+      case 'k':
+        AppendNumber(out, dt.hour, 1);
+        break;
+      case 'i':
+        AppendNumber(out, dt.minute, 2);
+        break;
+      case 's':
+      case 'S':
+        AppendNumber(out, dt.second, 2);
+        break;
+      case 'f':
+        AppendNumber(out, dt.microsecond, 6);
+        break;
+      case 'T':
+        AppendNumber(out, dt.hour, 2);
+        out.push_back(':');
+        AppendNumber(out, dt.minute, 2);
+        out.push_back(':');
+        AppendNumber(out, dt.second, 2);
+        break;
+      default:  // '%'
+        out.push_back(format[i]);
+        break;
+    }
+  }
+  s = types::BString(out.c_str(), out.size(), true);
+}
+
+}  // namespace core
+}  // namespace stonedb
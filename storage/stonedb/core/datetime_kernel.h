@@ -0,0 +1,113 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+#ifndef STONEDB_CORE_DATETIME_KERNEL_H_
+#define STONEDB_CORE_DATETIME_KERNEL_H_
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/common_definitions.h"
+#include "types/rc_data_types.h"
+
+class Item;
+
+namespace stonedb {
+namespace core {
+
+/*! \brief Native evaluation of common date/time functions on the packed
+ * (types::DT) representation of DATE and DATETIME columns.
+ *
+ * A kernel replaces the MySQL Item tree of expressions like YEAR(ts),
+ * DATE(ts), EXTRACT(YEAR_MONTH FROM ts), ts + INTERVAL 7 DAY or
+ * DATE_FORMAT(ts, '%Y-%m'), where the only variable is a single column.
+ * Values which MySQL treats specially (zero dates, results out of range) are
+ * not handled here: Apply() returns false and the caller must evaluate the
+ * row through the Item tree.
+ */
+class DateTimeKernel final {
+ public:
+  enum class Function {
+    YEAR,
+    QUARTER,
+    MONTH,
+    DAYOFMONTH,
+    HOUR,
+    MINUTE,
+    SECOND,
+    YEAR_MONTH,
+    TO_DAYS,
+    DATE,
+    ADD_INTERVAL,
+    DATE_FORMAT
+  };
+
+  /*! Recognize \e item as a supported function of a single column.
+   * \param item root of an expression tree, with fields already replaced by Item_sdbfield
+   * \param arg_type type of the only column used by the expression
+   * \param res_type result type of the expression, as computed by MysqlExpression::EvalType()
+   * \return a kernel, or nullptr if the expression has to be evaluated by MySQL
+   */
+  static std::shared_ptr<DateTimeKernel> Create(Item *item, common::CT arg_type, common::CT res_type);
+
+  /*! Compute the function for one packed argument value.
+   * \return false if the value must be computed by MySQL (the result is then
+   * undefined), true otherwise. NULL arguments give common::NULL_VALUE_64.
+   */
+  bool Apply(int64_t arg, int64_t &res) const;
+
+  /*! Compute the function for \e n values at once. Positions which cannot be
+   * computed natively get \e fallback_mark in \e out.
+   */
+  void Apply(const int64_t *in, int64_t *out, size_t n, int64_t fallback_mark) const;
+
+  /*! Rough range of the function for arguments from [arg_min, arg_max], e.g.
+   * taken from DPN statistics of a pack. Returns false if nothing better than
+   * the whole domain is known.
+   */
+  bool RoughRange(int64_t arg_min, int64_t arg_max, int64_t &res_min, int64_t &res_max) const;
+
+  //! True for DATE_FORMAT: Apply() passes the argument through and Format()
+  //! produces the text
+  bool StringResult() const { return func == Function::DATE_FORMAT; }
+  void Format(int64_t arg, types::BString &s) const;
+
+  Function GetFunction() const { return func; }
+
+ private:
+  DateTimeKernel(Function f, common::CT arg_type, common::CT res_type)
+      : func(f), arg_type(arg_type), res_type(res_type) {}
+
+  bool AddInterval(const types::DT &in, types::DT &out) const;
+
+  Function func;
+  common::CT arg_type;
+  common::CT res_type;
+
+  // ADD_INTERVAL only: the unit is normalized to months (for MONTH, QUARTER,
+  // YEAR) or seconds (for WEEK, DAY, HOUR, MINUTE, SECOND)
+  bool interval_in_months = false;
+  int64_t interval = 0;
+
+  // DATE_FORMAT only
+  std::string format;
+};
+
+}  // namespace core
+}  // namespace stonedb
+
+#endif  // STONEDB_CORE_DATETIME_KERNEL_H_
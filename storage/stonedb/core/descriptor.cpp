@@ -361,6 +361,27 @@ bool Descriptor::IsType_Subquery() {
           (val2.vc && val2.vc->IsSubSelect()));
 }
 
+bool Descriptor::IsType_StringProjection(const MIIterator &mit) const {
+  if (!encoded || !attr.vc || attr.vc->IsSingleColumn() != vcolumn::VirtualColumn::single_col_t::SC_RCATTR)
+    return false;
+  auto col = static_cast<RCAttr *>(static_cast<vcolumn::SingleColumn *>(attr.vc)->GetPhysical());
+  if (col->GetPackType() != common::PackType::STR) return false;
+  if (op == common::Operator::O_IS_NULL || op == common::Operator::O_NOT_NULL) return true;  // null masks only
+  if ((op != common::Operator::O_LIKE && op != common::Operator::O_NOT_LIKE) || !val1.vc || !val1.vc->IsConst() ||
+      types::RequiresUTFConversions(collation))
+    return false;
+  types::BString pattern;
+  val1.vc->GetValueString(pattern, mit);
+  return IsLikePrefix(pattern);  // prefix matches, see RCAttr::EvaluatePack_Like()
+}
+
+bool Descriptor::IsLikePrefix(const types::BString &pattern) const {
+  if (pattern.IsNullOrEmpty() || pattern.size() < 2 || pattern[pattern.size() - 1] != '%') return false;
+  for (uint i = 0; i < pattern.size() - 1; i++)
+    if (pattern[i] == '%' || pattern[i] == '_' || pattern[i] == like_esc) return false;
+  return true;
+}
+
 bool Descriptor::IsType_JoinSimple() const  // true if more than one table involved
 {
   DEBUG_ASSERT(desc_t != DescriptorJoinType::DT_NOT_KNOWN_YET);
@@ -862,10 +883,12 @@ void Descriptor::EvaluatePackImpl(MIUpdatingIterator &mit) {
 
 void Descriptor::EvaluatePack(MIUpdatingIterator &mit) {
   MEASURE_FET("Descriptor::EvaluatePack(...)");
-  if (GetParallelSize() == 0)
-    LockSourcePacks(mit);
-  else
-    MLockSourcePacks(mit, mit.GetTaskId());
+  if (!IsType_StringProjection(mit)) {  // string projections are read without loading the packs
+    if (GetParallelSize() == 0)
+      LockSourcePacks(mit);
+    else
+      MLockSourcePacks(mit, mit.GetTaskId());
+  }
   EvaluatePackImpl(mit);
 }
 
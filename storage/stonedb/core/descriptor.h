@@ -113,6 +113,10 @@ class Descriptor {
   bool IsParameterized() const;
   bool IsDeterministic() const;
   bool IsType_OrTree() const { return op == common::Operator::O_OR_TREE; }
+  // needs only a projection of string packs, see RCAttr::GetPackProjection()
+  bool IsType_StringProjection(const MIIterator &mit) const;
+  // 'pattern' is a prefix without wildcards followed by a single '%'
+  bool IsLikePrefix(const types::BString &pattern) const;
   bool IsType_JoinSimple() const;
   bool IsType_AttrAttr() const;
   bool IsType_AttrValOrAttrValVal() const;
@@ -187,6 +187,7 @@ Engine::Engine()
                        stonedb_sysvar_load_threads ? stonedb_sysvar_load_threads : std::thread::hardware_concurrency()),
       query_thread_pool(
           "query", stonedb_sysvar_query_threads ? stonedb_sysvar_query_threads : std::thread::hardware_concurrency()),
+      union_thread_pool("union", stonedb_sysvar_union_threads),
       insert_buffer(BUFFER_FILE, stonedb_sysvar_insert_buffer_size) {
   stonedb_data_dir = mysql_real_data_home;
 }
@@ -249,6 +250,7 @@ int Engine::Init(uint engine_slot) {
               delay_insert_thread_pool.size());
   STONEDB_LOG(LogCtl_Level::INFO, "StoneDB thread pool for load, size = %ld", load_thread_pool.size());
   STONEDB_LOG(LogCtl_Level::INFO, "StoneDB thread pool for query, size = %ld", query_thread_pool.size());
+  STONEDB_LOG(LogCtl_Level::INFO, "StoneDB thread pool for union, size = %ld", union_thread_pool.size());
 
   m_monitor_thread = std::thread([this] {
     struct job {
@@ -347,6 +349,8 @@ Engine::~Engine() {
   m_purge_thread.join();
   m_monitor_thread.join();
 
+  // cached filters and hash tables must go before their memory owners below
+  join_hash_cache.ReleaseAll();
   cache.ReleaseAll();
   table_share_map.clear();
   mem_table_map.clear();
@@ -767,6 +771,7 @@ void Engine::DeleteTable(const char *table, [[maybe_unused]] THD *thd) {
   auto id = RCTable::GetTableId(p);
   cache.ReleaseTable(id);
   filter_cache.RemoveIf([id](const FilterCoordinate &c) { return c[0] == int(id); });
+  join_hash_cache.ReleaseTable(id);
 
   {
     std::scoped_lock lk(gc_tasks_mtx);
@@ -786,9 +791,31 @@ void Engine::TruncateTable(const std::string &table_path, [[maybe_unused]] THD *
   auto id = tab->GetID();
   cache.ReleaseTable(id);
   filter_cache.RemoveIf([id](const FilterCoordinate &c) { return c[0] == int(id); });
+  join_hash_cache.ReleaseTable(id);
   STONEDB_LOG(LogCtl_Level::INFO, "Truncated table %s, ID = %u", table_path.c_str(), id);
 }
 
+bool Engine::RebuildRoughIndexes(const std::string &table_path, TABLE *table, THD *thd) {
+  // columns chosen with stonedb_rebuild_filters_columns, all if none
+  std::vector<bool> cols;
+  std::stringstream ss(stonedb_sysvar_rebuild_filters_columns ? stonedb_sysvar_rebuild_filters_columns : "");
+  for (std::string name; std::getline(ss, name, ',');) {
+    boost::trim(name);
+    if (name.empty()) continue;
+    cols.resize(table->s->fields);
+    uint i = 0;
+    while (i < table->s->fields && my_strcasecmp(system_charset_info, table->s->field[i]->field_name, name.c_str()))
+      i++;
+    if (i == table->s->fields)
+      throw common::Exception("Unknown column '" + name + "' in stonedb_rebuild_filters_columns");
+    cols[i] = true;
+  }
+
+  // the new filters are saved as new versions at commit, the cached ones stay valid for older snapshots
+  auto tab = GetTx(thd)->GetTableByPath(table_path);
+  return tab->RebuildRoughIndexes(cols, stonedb_sysvar_rebuild_filters_packs, stonedb_sysvar_rebuild_filters_threads);
+}
+
 void Engine::GetTableIterator(const std::string &table_path, RCTable::Iterator &iter_begin, RCTable::Iterator &iter_end,
                               std::shared_ptr<RCTable> &table, const std::vector<bool> &attrs, THD *thd) {
   table = GetTx(thd)->GetTableByPath(table_path);
@@ -1058,6 +1085,7 @@ void Engine::RenameTable([[maybe_unused]] Transaction *trans, const std::string
   auto id = RCTable::GetTableId(from + common::STONEDB_EXT);
   cache.ReleaseTable(id);
   filter_cache.RemoveIf([id](const FilterCoordinate &c) { return c[0] == int(id); });
+  join_hash_cache.ReleaseTable(id);
   system::RenameFile(stonedb_data_dir / (from + common::STONEDB_EXT), stonedb_data_dir / (to + common::STONEDB_EXT));
   RenameRdbTable(from, to);
   UnregisterMemTable(from, to);
@@ -27,6 +27,7 @@
 #include "common/assert.h"
 #include "common/exception.h"
 #include "core/data_cache.h"
+#include "core/join_hash_cache.h"
 #include "core/object_cache.h"
 #include "core/query.h"
 #include "core/rc_table.h"
@@ -79,6 +80,8 @@ class Engine final {
   void CreateTable(const std::string &table, TABLE *from);
   void DeleteTable(const char *table, THD *thd);
   void TruncateTable(const std::string &table_path, THD *thd);
+  // return true if all packs are done, false if some are left for the next call
+  bool RebuildRoughIndexes(const std::string &table_path, TABLE *table, THD *thd);
   void RenameTable(Transaction *trans, const std::string &from, const std::string &to, THD *thd);
   void PrepareAlterTable(const std::string &table_path, std::vector<Field *> &new_cols, std::vector<Field *> &old_cols,
                          THD *thd);
@@ -137,8 +140,10 @@ class Engine final {
   utils::thread_pool delay_insert_thread_pool;
   utils::thread_pool load_thread_pool;
   utils::thread_pool query_thread_pool;
+  utils::thread_pool union_thread_pool;
   DataCache cache;
   ObjectCache<FilterCoordinate, RSIndex, FilterCoordinate> filter_cache;
+  JoinHashCache join_hash_cache;
 
  public:
   static common::CT GetCorrespondingType(const Field &field);
@@ -289,6 +294,11 @@ class ResultSender {
 
   virtual void Init(TempTable *t);
   virtual void SendRecord(const std::vector<std::unique_ptr<types::RCDataType>> &record);
+
+ private:
+  using Page = std::vector<std::vector<std::unique_ptr<types::RCDataType>>>;
+  void PreparePage(TempTable::RecordIterator *iter, const TempTable::RecordIterator *iter_end, Transaction *tx,
+                   Page *page);
 };
 
 class ResultExportSender final : public ResultSender {
@@ -22,6 +22,7 @@
 #include "core/compilation_tools.h"
 #include "core/compiled_query.h"
 #include "core/engine.h"
+#include "core/fallback_stat.h"
 #include "core/query.h"
 #include "core/transaction.h"
 #include "exporter/export2file.h"
@@ -105,6 +106,7 @@ int Engine::HandleSelect(THD *thd, LEX *lex, Query_result *&result, ulong setup_
   query_cache.store_query(thd, thd->lex->query_tables);
 
   stonedb_stat.select++;
+  current_tx->ResetFallbackReason();
 
   // at this point all tables are in RCBase engine, so we can proceed with the
   // query and we know that if the result goes to the file, the SDB_DATAFORMAT is
@@ -130,6 +132,7 @@ int Engine::HandleSelect(THD *thd, LEX *lex, Query_result *&result, ulong setup_
           if (first_select->next_select() && first_select->next_select()->linkage == UNION_TYPE) {  //?? only if union
             if (lex->is_explain() || cursor->derived_unit()->item) {  //??called for explain
               // OR there is subselect(?)
+              current_tx->SetFallbackReason("UNION in a derived table under EXPLAIN or a subquery");
               route = RETURN_QUERY_TO_MYSQL_ROUTE;
               goto ret_derived;
             }
@@ -152,8 +155,10 @@ int Engine::HandleSelect(THD *thd, LEX *lex, Query_result *&result, ulong setup_
             if (optimize_derived_after_sdb) derived_optimized.push_back(cursor->derived_unit());
           }
           lex->set_current_select(save_current_select);
-          if (!res && free_join)  // no error &
+          if (!res && free_join) {  // no error &
+            current_tx->SetFallbackReason("derived table");
             route = RETURN_QUERY_TO_MYSQL_ROUTE;
+          }
           if (res || route == RETURN_QUERY_TO_MYSQL_ROUTE) goto ret_derived;
         }
     lex->thd->derived_tables_processing = FALSE;
@@ -174,9 +179,10 @@ int Engine::HandleSelect(THD *thd, LEX *lex, Query_result *&result, ulong setup_
          != 0) { my_error(ER_TABLE_EXISTS_ERROR, MYF(0),
          sc->create_table->table_name); res = 1; } else
        */
-      if (lex->is_explain() || unit->item)  // explain or sth was already computed - go to mysql
+      if (lex->is_explain() || unit->item) {  // explain or sth was already computed - go to mysql
+        current_tx->SetFallbackReason(lex->is_explain() ? "EXPLAIN of a UNION" : "UNION in a subquery");
         route = RETURN_QUERY_TO_MYSQL_ROUTE;
-      else {
+      } else {
         int old_executed = unit->is_executed();
         res = unit->optimize_for_stonedb();  //====exec()
         optimize_after_sdb = TRUE;
@@ -285,6 +291,13 @@ ret_derived:
   // optimization of derived tables must be completed
   // and derived tables must be filled
   if (route == RETURN_QUERY_TO_MYSQL_ROUTE) {
+    // the reason is set by the first check that failed; only a few of the
+    // paths to here do not set one
+    current_tx->SetFallbackReason("unsupported syntax");
+    FallbackStat::Add(current_tx->GetFallbackReason());
+    push_warning(thd, Sql_condition::SL_NOTE, ER_UNKNOWN_ERROR,
+                 ("Query executed by MySQL engine, not supported by StoneDB: " + current_tx->GetFallbackReason())
+                     .c_str());
     for (SELECT_LEX *sl = lex->all_selects_list; sl; sl = sl->next_select_in_list())
       for (TABLE_LIST *cursor = sl->get_table_list(); cursor; cursor = cursor->next_local)
         if (cursor->table && cursor->is_derived()) {
@@ -365,8 +378,7 @@ int Engine::Execute(THD *thd, LEX *lex, Query_result *result_output, SELECT_LEX_
   int is_dumpfile = 0;
   const char *export_file_name = GetFilename(selects_list, is_dumpfile);
   if (is_dumpfile) {
-    push_warning(thd, Sql_condition::SL_NOTE, ER_UNKNOWN_ERROR,
-                 "Dumpfile not implemented in StoneDB, executed by MySQL engine.");
+    current_tx->SetFallbackReason("SELECT ... INTO DUMPFILE");
     return RETURN_QUERY_TO_MYSQL_ROUTE;
   }
 
@@ -378,8 +390,7 @@ int Engine::Execute(THD *thd, LEX *lex, Query_result *result_output, SELECT_LEX_
 
   try {
     if (!query.Compile(&cqu, selects_list, last_distinct)) {
-      push_warning(thd, Sql_condition::SL_NOTE, ER_UNKNOWN_ERROR,
-                   "Query syntax not implemented in StoneDB, executed by MySQL engine.");
+      current_tx->SetFallbackReason("unsupported syntax");
       return RETURN_QUERY_TO_MYSQL_ROUTE;
     }
   } catch (common::Exception const &x) {
@@ -459,6 +470,7 @@ int handle_exceptions(THD *thd, Transaction *cur_connection, bool with_error) {
     throw;
   } catch (common::NotImplementedException const &x) {
     rccontrol.lock(cur_connection->GetThreadID()) << "Switched to MySQL: " << x.what() << system::unlock;
+    cur_connection->SetFallbackReason(x.what());
     my_message(ER_UNKNOWN_ERROR,
                (std::string("The query includes syntax that is not supported "
                             "by the storage engine. StoneDB: ") +
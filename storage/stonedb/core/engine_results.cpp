@@ -356,11 +356,69 @@ void ResultSender::SendRecord(const std::vector<std::unique_ptr<types::RCDataTyp
   res->send_data(fields);
 }
 
+// Copy the values of the next page of records (at most result_sender_rows) out
+// of the attribute buffers; strings are made persistent, as a buffer page they
+// point to may be replaced while reading the following records.
+void ResultSender::PreparePage(TempTable::RecordIterator *iter, const TempTable::RecordIterator *iter_end,
+                               Transaction *tx, Page *page) {
+  current_tx = tx;
+  page->clear();
+  TempTable *owner = iter->Owner();
+  std::vector<bool> is_string(owner->NumOfDisplaybleAttrs());
+  for (uint att = 0; att < is_string.size(); att++)
+    is_string[att] = ATI::IsStringType(owner->GetDisplayableAttrP(att)->TypeName());
+
+  for (; *iter != *iter_end && page->size() < stonedb_sysvar_result_sender_rows; ++(*iter)) {
+    if ((iter->currentRowNumber() & 0x7fff) == 0)
+      if (tx->Killed()) throw common::KilledException();
+    TempTable::Record record(**iter);
+    auto &row = page->emplace_back();
+    row.reserve(is_string.size());
+    for (uint att = 0; att < is_string.size(); att++) {
+      row.emplace_back(record.m_it.dataTypes[att]->Clone());
+      if (is_string[att]) static_cast<types::BString *>(row.back().get())->MakePersistent();
+    }
+  }
+}
+
 void ResultSender::Send(TempTable *t) {
   DEBUG_ASSERT(t->IsMaterialized());
   t->CreateDisplayableAttrP();
   TempTable::RecordIterator iter = t->begin();
   TempTable::RecordIterator iter_end = t->end();
+  // rows skipped by the offset are not read at all
+  for (; iter != iter_end && offset && *offset > 0; ++iter) Send(iter);
+
+  if (uint64_t(t->NumOfObj()) - iter.currentRowNumber() > stonedb_sysvar_result_sender_rows &&
+      !rceng->query_thread_pool.is_owner()) {
+    // Pipelined: the next page of records is read on the query pool while the
+    // current one is converted and sent. Fields and the protocol belong to the
+    // session, so the conversion stays on this thread.
+    if (!is_initialized) {
+      // done here, not by the first SendRow(): it rebuilds the displayable
+      // attributes, which the pool is reading by then
+      Init(t);
+      is_initialized = true;
+    }
+    Page pages[2];
+    auto next = rceng->query_thread_pool.add_task(&ResultSender::PreparePage, this, &iter, &iter_end, current_tx,
+                                                  &pages[0]);
+    try {
+      for (int cur = 0;; cur ^= 1) {
+        next.get();
+        bool more = (iter != iter_end && !(limit && *limit <= int64_t(pages[cur].size())));
+        if (more)
+          next = rceng->query_thread_pool.add_task(&ResultSender::PreparePage, this, &iter, &iter_end, current_tx,
+                                                   &pages[cur ^ 1]);
+        for (auto &row : pages[cur]) SendRow(row, t);
+        if (!more) break;
+      }
+    } catch (...) {
+      if (next.valid()) next.wait();
+      throw;
+    }
+  }
+  // the rest, or rows beyond the limit which are only counted for found_rows()
   for (; iter != iter_end; ++iter) {
     Send(iter);
   }
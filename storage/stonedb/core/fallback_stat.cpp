@@ -0,0 +1,55 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+
+#include "fallback_stat.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+namespace stonedb {
+namespace core {
+std::atomic<uint64_t> FallbackStat::total{0};
+std::mutex FallbackStat::mtx;
+std::map<std::string, uint64_t> FallbackStat::counts;
+
+void FallbackStat::Add(const std::string &reason) {
+  total++;
+  std::scoped_lock guard(mtx);
+  auto it = counts.find(reason);
+  if (it != counts.end())
+    it->second++;
+  else if (counts.size() < MAX_REASONS)
+    counts.emplace(reason, 1);
+  else
+    counts["other"]++;
+}
+
+std::string FallbackStat::Report() {
+  std::vector<std::pair<std::string, uint64_t>> sorted;
+  {
+    std::scoped_lock guard(mtx);
+    sorted.assign(counts.begin(), counts.end());
+  }
+  std::stable_sort(sorted.begin(), sorted.end(), [](auto &a, auto &b) { return a.second > b.second; });
+  std::stringstream ss;
+  for (auto &r : sorted) ss << (ss.tellp() > 0 ? "; " : "") << r.first << ": " << r.second;
+  return ss.str();
+}
+
+}  // namespace core
+}  // namespace stonedb
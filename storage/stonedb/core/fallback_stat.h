@@ -0,0 +1,51 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+#ifndef STONEDB_CORE_FALLBACK_STAT_H_
+#define STONEDB_CORE_FALLBACK_STAT_H_
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace stonedb {
+namespace core {
+
+// Queries on StoneDB tables handed over to the MySQL execution path, counted
+// by the reason recorded with Transaction::SetFallbackReason()
+class FallbackStat {
+ public:
+  static void Add(const std::string &reason);
+  static uint64_t Total() { return total; }
+  // "reason: count; ..." with the most frequent reasons first
+  static std::string Report();
+
+ private:
+  // the reasons are fixed strings or exception messages; anything beyond this
+  // many distinct ones is counted as "other"
+  static constexpr size_t MAX_REASONS = 64;
+
+  static std::atomic<uint64_t> total;
+  static std::mutex mtx;
+  static std::map<std::string, uint64_t> counts;
+};
+
+}  // namespace core
+}  // namespace stonedb
+
+#endif  // STONEDB_CORE_FALLBACK_STAT_H_
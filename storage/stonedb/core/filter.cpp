@@ -541,19 +541,19 @@ bool Filter::IsEqual(Filter &sec) {
   if (no_blocks != sec.no_blocks || no_of_bits_in_last_block != sec.no_of_bits_in_last_block) return false;
   for (size_t b = 0; b < no_blocks; b++) {
     if (block_status[b] != sec.block_status[b]) {
-      int64_t bstart = int64_t(b) >> no_power;
+      int64_t bstart = int64_t(b) << no_power;
       int64_t bstop = bstart + (b < no_blocks - 1 ? (pack_def - 1) : no_of_bits_in_last_block - 1);
       if (block_status[b] == FB_FULL && sec.block_status[b] == FB_MIXED) {  // Note: may still be equal!
         if (!sec.IsFullBetween(bstart, bstart + block_last_one[b])) return false;
         if (bstart + block_last_one[b] < bstop && !sec.IsEmptyBetween(bstart + block_last_one[b] + 1, bstop))
           return false;
-        return true;
+        continue;
       }
       if (sec.block_status[b] == FB_FULL && block_status[b] == FB_MIXED) {  // Note: may still be equal!
         if (!IsFullBetween(bstart, bstart + sec.block_last_one[b])) return false;
         if (bstart + sec.block_last_one[b] < bstop && !IsEmptyBetween(bstart + sec.block_last_one[b] + 1, bstop))
           return false;
-        return true;
+        continue;
       }
       return false;
     }
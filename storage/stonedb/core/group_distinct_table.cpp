@@ -60,7 +60,7 @@ void GroupDistinctTable::InitializeVC(int64_t max_no_groups, vcolumn::VirtualCol
     max_total_size = 1_GB;
   if (max_no_rows == common::NULL_VALUE_64) max_no_rows = 0;  // not known
   encoder = new ColumnBinEncoder(
-      ColumnBinEncoder::ENCODER_IGNORE_NULLS |
+      ColumnBinEncoder::ENCODER_IGNORE_NULLS | ColumnBinEncoder::ENCODER_INTERNED |
       (decodable ? ColumnBinEncoder::ENCODER_DECODABLE : 0));  // non-monotonic comparable, usually not decodable
   encoder->PrepareEncoder(vc);
   // Filter implementation, if possible:
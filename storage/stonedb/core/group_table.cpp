@@ -50,6 +50,23 @@ GroupTable::~GroupTable() {
 }
 
 GroupTable::GroupTable(const GroupTable &sec) : mm::TraceableObject(sec) {
+  CopyColumns(sec);
+  if (sec.vm_tab) vm_tab.reset(sec.vm_tab->Clone());
+}
+
+GroupTable::GroupTable(const GroupTable &sec, int64_t max_no_groups) : mm::TraceableObject(sec) {
+  CopyColumns(sec);
+  declared_max_no_groups = max_no_groups;
+  max_total_size = mm::TraceableObject::MaxBufferSizeForAggr(int64_t(ceil(max_no_groups * total_width * 1.3)));
+  vm_tab.reset(ValueMatchingTable::CreateNew_ValueMatchingTable(max_total_size, declared_max_no_groups,
+                                                                common::PLUS_INF_64, total_width, grouping_and_UTF_width,
+                                                                grouping_buf_width, p_power));
+  // the statistics of 'sec' are not valid for a subset of its groups
+  for (int i = 0; i < no_grouping_attr; i++) encoder[i]->ClearStatistics();
+  for (int i = no_grouping_attr; i < no_attr; i++) aggregator[i]->ResetStatistics();
+}
+
+void GroupTable::CopyColumns(const GroupTable &sec) {
   DEBUG_ASSERT(sec.initialized);  // can only copy initialized GroupTables!
   // Some fields are omitted (empty vectors), as they are used only for
   // Initialize()
@@ -70,8 +87,6 @@ GroupTable::GroupTable(const GroupTable &sec) : mm::TraceableObject(sec) {
   encoder.resize(no_attr);
   vc.resize(no_attr);
 
-  if (sec.vm_tab) vm_tab.reset(sec.vm_tab->Clone());
-
   max_total_size = sec.max_total_size;
   vc_owner.reserve(no_attr);
   aggregated_col_offset = sec.aggregated_col_offset;
@@ -164,7 +179,7 @@ void GroupTable::Initialize(int64_t max_no_groups, bool parallel_allowed) {
       desc = grouping_desc[i];
       vc[i] = desc.vc;
       // TODO: not always decodable? (hidden cols)
-      encoder[i] = new ColumnBinEncoder(ColumnBinEncoder::ENCODER_DECODABLE);
+      encoder[i] = new ColumnBinEncoder(ColumnBinEncoder::ENCODER_DECODABLE | ColumnBinEncoder::ENCODER_INTERNED);
       encoder[i]->PrepareEncoder(desc.vc);
     } else {
       desc = aggregated_desc[i - no_grouping_attr];
@@ -439,6 +454,35 @@ void GroupTable::Merge(GroupTable &sec, Transaction *m_conn) {
   sec.vm_tab->Clear();
 }
 
+int GroupTable::PartOfRow(int64_t row, int no_parts) {
+  if (grouping_buf_width == 0) return 0;
+  uint32_t crc_code = HashValue(vm_tab->GetGroupingRow(row), grouping_buf_width);
+  // hash tables of the partitions use the lowest bits of the same code, so take the partition from the highest
+  // bits of a mixed code, otherwise all groups of a partition would fall into a fraction of the hash positions
+  return int((uint64_t(uint32_t(crc_code * 2654435761u)) * no_parts) >> 32);
+}
+
+void GroupTable::MergePart(GroupTable &sec, int part, int no_parts, Transaction *m_conn) {
+  DEBUG_ASSERT(total_width == sec.total_width);
+  int64_t row;
+  for (int64_t n = 0; n < sec.vm_tab->NoRows(); n++) {
+    if (m_conn->Killed()) throw common::KilledException();
+    int64_t sec_row = sec.vm_tab->GetRowAt(n);
+    if (sec.PartOfRow(sec_row, no_parts) != part) continue;
+    not_full = true;  // the size of a partition is only estimated, it must take all its groups
+    if (grouping_and_UTF_width > 0)
+      std::memcpy(input_buffer.data(), sec.vm_tab->GetGroupingRow(sec_row), grouping_and_UTF_width);
+    FindCurrentRow(row);  // find the value on another position or add as a new one
+    if (row != common::NULL_VALUE_64) {
+      unsigned char *p1 = vm_tab->GetAggregationRow(row);
+      unsigned char *p2 = sec.vm_tab->GetAggregationRow(sec_row);
+      for (int col = no_grouping_attr; col < no_attr; col++) {
+        aggregator[col]->Merge(p1 + aggregated_col_offset[col], p2 + sec.aggregated_col_offset[col]);
+      }
+    }
+  }
+}
+
 int64_t GroupTable::GetValue64(int col, int64_t row) {
   if (col >= no_grouping_attr) {
     return aggregator[col]->GetValue64(vm_tab->GetAggregationRow(row) + aggregated_col_offset[col]);
@@ -547,21 +591,26 @@ bool GroupTable::PutAggregatedValue(int col, int64_t row, MIIterator &mit, int64
     }
     factor = 1;  // ignore repetitions for distinct
   }
+  if (!as_string)
+    // note: it is too costly to check nulls separately (e.g. for complex
+    // expressions)
+    return PutAggregatedValue64(col, row, vc[col]->GetValueInt64(mit), factor);
   STONEDBAggregator *cur_aggr = aggregator[col];
   if (factor == common::NULL_VALUE_64 && cur_aggr->FactorNeeded())
     throw common::NotImplementedException("Aggregation overflow.");
-  if (as_string) {
-    types::BString v;
-    vc[col]->GetValueString(v, mit);
-    if (v.IsNull() && cur_aggr->IgnoreNulls()) return true;  // null omitted
-    cur_aggr->PutAggregatedValue(vm_tab->GetAggregationRow(row) + aggregated_col_offset[col], v, factor);
-  } else {
-    // note: it is too costly to check nulls separately (e.g. for complex
-    // expressions)
-    int64_t v = vc[col]->GetValueInt64(mit);
-    if (v == common::NULL_VALUE_64 && cur_aggr->IgnoreNulls()) return true;
-    cur_aggr->PutAggregatedValue(vm_tab->GetAggregationRow(row) + aggregated_col_offset[col], v, factor);
-  }
+  types::BString v;
+  vc[col]->GetValueString(v, mit);
+  if (v.IsNull() && cur_aggr->IgnoreNulls()) return true;  // null omitted
+  cur_aggr->PutAggregatedValue(vm_tab->GetAggregationRow(row) + aggregated_col_offset[col], v, factor);
+  return true;
+}
+
+bool GroupTable::PutAggregatedValue64(int col, int64_t row, int64_t v, int64_t factor) {
+  STONEDBAggregator *cur_aggr = aggregator[col];
+  if (factor == common::NULL_VALUE_64 && cur_aggr->FactorNeeded())
+    throw common::NotImplementedException("Aggregation overflow.");
+  if (v == common::NULL_VALUE_64 && cur_aggr->IgnoreNulls()) return true;
+  cur_aggr->PutAggregatedValue(vm_tab->GetAggregationRow(row) + aggregated_col_offset[col], v, factor);
   return true;
 }
 
@@ -55,6 +55,8 @@ class GroupTable : public mm::TraceableObject {
  public:
   GroupTable(uint32_t power);
   GroupTable(const GroupTable &sec);
+  // an empty table with the columns of 'sec', for up to max_no_groups groups
+  GroupTable(const GroupTable &sec, int64_t max_no_groups);
   ~GroupTable();
 
   // Group table construction
@@ -101,6 +103,8 @@ class GroupTable : public mm::TraceableObject {
   bool PutAggregatedValue(int col, int64_t row,
                           int64_t factor);  // for aggregations which do not need any value
   bool PutAggregatedValue(int col, int64_t row, MIIterator &mit, int64_t factor, bool as_string);
+  // a numerical value already read, for not distinct aggregations
+  bool PutAggregatedValue64(int col, int64_t row, int64_t v, int64_t factor);
   bool PutAggregatedNull(int col, int64_t row, bool as_string);
   // mainly for numerics, and only some aggregators
   bool PutCachedValue(int col, GroupDistinctCache &cache, bool as_text);
@@ -113,6 +117,11 @@ class GroupTable : public mm::TraceableObject {
   void AddCurrentValueToCache(int col, GroupDistinctCache &cache);
   void Merge(GroupTable &sec,
              Transaction *m_conn);  // merge values from another (compatible) GroupTable
+  // Merge only the groups of partition 'part' (out of 'no_parts', by hash of
+  // the grouping values). 'sec' is not changed, so several partitions of it
+  // may be merged at once into different tables.
+  void MergePart(GroupTable &sec, int part, int no_parts, Transaction *m_conn);
+  int PartOfRow(int64_t row, int no_parts);  // partition of a stored group
   // Group table output and info
 
   bool IsFull() { return !not_full; }  // no place left or all groups found
@@ -156,6 +165,8 @@ class GroupTable : public mm::TraceableObject {
   mm::TO_TYPE TraceableType() const override { return mm::TO_TYPE::TO_TEMPORARY; }
 
  private:
+  void CopyColumns(const GroupTable &sec);  // all but the contents (vm_tab)
+
   std::vector<unsigned char> input_buffer;
   std::vector<int> aggregated_col_offset;  // a table of byte offsets of
                                            // aggregated column beginnings wrt.
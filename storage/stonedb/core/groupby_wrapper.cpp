@@ -30,6 +30,8 @@ GroupByWrapper::GroupByWrapper(int a_size, bool distinct, Transaction *conn, uin
   is_lookup = new bool[attrs_size];
   attr_mapping = new int[attrs_size];  // output attr[j] <-> gt group[attr_mapping[j]]
   dist_vals = new int64_t[attrs_size];
+  pack_values.resize(attrs_size);
+  pack_value_read.resize(attrs_size, false);
 
   for (int i = 0; i < attrs_size; i++) {
     virt_col[i] = nullptr;
@@ -65,6 +67,16 @@ GroupByWrapper::~GroupByWrapper() {
 
 GroupByWrapper::GroupByWrapper(const GroupByWrapper &sec)
     : distinct_watch(sec.p_power), m_conn(sec.m_conn), gt(sec.gt) {
+  CopyAttrs(sec);
+}
+
+GroupByWrapper::GroupByWrapper(const GroupByWrapper &sec, int64_t max_no_groups)
+    : distinct_watch(sec.p_power), m_conn(sec.m_conn), gt(sec.gt, max_no_groups) {
+  CopyAttrs(sec);
+  no_groups = 0;
+}
+
+void GroupByWrapper::CopyAttrs(const GroupByWrapper &sec) {
   p_power = sec.p_power;
   attrs_size = sec.attrs_size;
   just_distinct = sec.just_distinct;
@@ -73,6 +85,8 @@ GroupByWrapper::GroupByWrapper(const GroupByWrapper &sec)
   is_lookup = new bool[attrs_size];
   attr_mapping = new int[attrs_size];  // output attr[j] <-> gt group[attr_mapping[j]]
   dist_vals = new int64_t[attrs_size];
+  pack_values.resize(attrs_size);
+  pack_value_read.resize(attrs_size, false);
 
   for (int i = 0; i < attrs_size; i++) {
     attr_mapping[i] = sec.attr_mapping[i];
@@ -275,6 +289,11 @@ void GroupByWrapper::Merge(GroupByWrapper &sec) {
   no_groups += gt.GetNoOfGroups() - old_groups;
 }
 
+void GroupByWrapper::MergePart(const std::vector<GroupByWrapper *> &srcs, int part, int no_parts) {
+  for (auto sec : srcs) gt.MergePart(sec->gt, part, no_parts, m_conn);
+  no_groups = gt.GetNoOfGroups();
+}
+
 bool GroupByWrapper::AggregatePackInOneGroup(int attr_no, MIIterator &mit, int64_t uniform_pos, int64_t rows_in_pack,
                                              int64_t factor) {
   bool no_omitted = (rows_in_pack == mit.GetPackSizeLeft());
@@ -509,6 +528,25 @@ bool GroupByWrapper::PutAggregatedValue(int gr_a, int64_t pos, MIIterator &mit,
   return gt.PutAggregatedValue(gr_a, pos, mit, factor, (input_mode[gr_a] == GBInputMode::GBIMODE_AS_TEXT));
 }
 
+void GroupByWrapper::ReadPackValues(MIIterator &mit) {
+  int64_t rows = mit.GetPackSizeLeft();
+  for (int gr_a = no_grouping_attr; gr_a < no_attr; gr_a++) {
+    pack_value_read[gr_a] = false;
+    if (!ColumnNotOmitted(gr_a) || !virt_col[gr_a] || input_mode[gr_a] != GBInputMode::GBIMODE_AS_INT64 ||
+        gt.AttrDistinct(gr_a) || rows <= 0 || rows > (int64_t(1) << p_power))  // e.g. packrows of joins
+      continue;
+    std::vector<int64_t> &values = pack_values[gr_a];
+    values.resize(rows);
+    MIIterator batch_mit(mit);
+    size_t n = 0;
+    while (n < values.size() && batch_mit.IsValid()) {
+      n += virt_col[gr_a]->GetValuesInt64(batch_mit, values.data() + n, values.size() - n);
+      if (batch_mit.PackrowStarted()) break;
+    }
+    pack_value_read[gr_a] = true;
+  }
+}
+
 types::BString GroupByWrapper::GetValueT(int col, int64_t row) {
   if (is_lookup[col]) {
     int64_t v = GetValue64(col, row);  // lookup code
@@ -667,6 +705,7 @@ void GroupByWrapper::LockPackAlways(int i, MIIterator &mit) {
 void GroupByWrapper::ResetPackrow() {
   for (int i = 0; i < no_attr; i++) {
     pack_not_omitted[i] = true;  // reset information about packrow
+    pack_value_read[i] = false;
   }
 }
 
@@ -60,6 +60,8 @@ class GroupByWrapper final {
  public:
   GroupByWrapper(int attrs_size, bool distinct, Transaction *conn, uint32_t power);
   GroupByWrapper(const GroupByWrapper &sec);
+  // an empty wrapper of the same columns, for up to max_no_groups groups
+  GroupByWrapper(const GroupByWrapper &sec, int64_t max_no_groups);
   GroupByWrapper &operator=(const GroupByWrapper &) = delete;
   ~GroupByWrapper();
 
@@ -82,6 +84,14 @@ class GroupByWrapper final {
   void PutGroupingValue(int gr_a, MIIterator &mit) { gt.PutGroupingValue(gr_a, mit); }
   bool PutAggregatedNull(int gr_a, int64_t pos);
   bool PutAggregatedValue(int gr_a, int64_t pos, MIIterator &mit, int64_t factor = 1);
+  // read the numerical values of the aggregated columns for the rows from mit
+  // to the end of its packrow at once, see PackValueRead()
+  void ReadPackValues(MIIterator &mit);
+  bool PackValueRead(int gr_a) { return pack_value_read[gr_a]; }
+  // the value of the row-th row since ReadPackValues()
+  bool PutPackValue(int gr_a, int64_t pos, int64_t row, int64_t factor = 1) {
+    return gt.PutAggregatedValue64(gr_a, pos, pack_values[gr_a][row], factor);
+  }
   // return value: true if value checked in, false if not (DISTINCT buffer
   // overflow) functionalities around DISTINCT
   bool PutAggregatedValueForCount(int gr_a, int64_t pos,
@@ -143,6 +153,15 @@ class GroupByWrapper final {
   bool IsOnePass() { return gt.IsOnePass(); }
   int MemoryBlocksLeft() { return gt.MemoryBlocksLeft(); }  // no place left for more packs (soft limit)
   void Merge(GroupByWrapper &sec);
+  // Merge the groups of partition 'part' of all 'srcs' into this (empty)
+  // wrapper; 'srcs' are only read, see GroupTable::MergePart()
+  void MergePart(const std::vector<GroupByWrapper *> &srcs, int part, int no_parts);
+  // the groups were merged by MergePart() into other wrappers: free them, but
+  // keep 'merged_groups' as the number of groups found
+  void MovedToParts(int64_t merged_groups) {
+    gt.ClearAll();
+    no_groups = merged_groups;
+  }
   // A filter of rows to be aggregated
 
   void InitTupleLeft(int64_t n);
@@ -191,6 +210,8 @@ class GroupByWrapper final {
     GBIMODE_AS_INT64,
     GBIMODE_AS_TEXT
   };
+  void CopyAttrs(const GroupByWrapper &sec);
+
   uint32_t p_power;
   int attrs_size;
   int no_grouping_attr;
@@ -209,6 +230,9 @@ class GroupByWrapper final {
   bool *pack_not_omitted;  // pack status for columns in current packrow
   int64_t *dist_vals;      // distinct values for column - upper approximation
 
+  std::vector<std::vector<int64_t>> pack_values;  // see ReadPackValues()
+  std::vector<bool> pack_value_read;
+
   GroupTable gt;
 
   Filter *tuple_left;  // a mask of all rows still to be aggregated
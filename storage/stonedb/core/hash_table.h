@@ -47,6 +47,7 @@ class HashTable : public mm::TraceableObject {
 
   size_t GetKeyBufferWidth() const { return key_buf_width_; }
   int64_t GetCount() const { return rows_count_; }
+  size_t GetMemorySize() const { return total_width_ * rows_count_; }
   int64_t AddKeyValue(const std::string &key_buffer, bool *too_many_conflicts = nullptr);
   void SetTupleValue(int col, int64_t row, int64_t value);
   int64_t GetTupleValue(int col, int64_t row);
@@ -0,0 +1,80 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+
+#include "core/join_hash_cache.h"
+
+#include "system/configuration.h"
+
+namespace stonedb {
+namespace core {
+bool JoinHashCache::Enabled() { return stonedb_sysvar_join_cache_size > 0; }
+
+std::shared_ptr<const JoinHashCache::Entry> JoinHashCache::Get(const std::string &key, Filter &filter) {
+  std::scoped_lock lk(mtx);
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if ((*it)->key == key && filter.IsEqual(*(*it)->filter)) {
+      entries.splice(entries.begin(), entries, it);
+      hits++;
+      return entries.front();
+    }
+  }
+  misses++;
+  return nullptr;
+}
+
+void JoinHashCache::Put(std::shared_ptr<Entry> entry) {
+  size_t limit = size_t(stonedb_sysvar_join_cache_size) << 20;
+  if (entry->size > limit) return;
+
+  std::scoped_lock lk(mtx);
+  for (auto &e : entries)
+    if (e->key == entry->key && e->filter->IsEqual(*entry->filter)) return;  // built concurrently by another query
+  Evict(limit - entry->size);
+  total_size += entry->size;
+  entries.push_front(std::move(entry));
+}
+
+void JoinHashCache::ReleaseTable(uint32_t table_id) {
+  std::scoped_lock lk(mtx);
+  for (auto it = entries.begin(); it != entries.end();) {
+    if ((*it)->table_id == table_id) {
+      total_size -= (*it)->size;
+      it = entries.erase(it);
+    } else
+      ++it;
+  }
+}
+
+void JoinHashCache::Shrink() {
+  std::scoped_lock lk(mtx);
+  Evict(size_t(stonedb_sysvar_join_cache_size) << 20);
+}
+
+void JoinHashCache::ReleaseAll() {
+  std::scoped_lock lk(mtx);
+  Evict(0);
+}
+
+void JoinHashCache::Evict(size_t limit) {
+  // the queries still using an evicted entry keep it alive
+  while (total_size > limit && !entries.empty()) {
+    total_size -= entries.back()->size;
+    entries.pop_back();
+  }
+}
+}  // namespace core
+}  // namespace stonedb
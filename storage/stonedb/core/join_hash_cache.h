@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+#ifndef STONEDB_CORE_JOIN_HASH_CACHE_H_
+#define STONEDB_CORE_JOIN_HASH_CACHE_H_
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/column_bin_encoder.h"
+#include "core/filter.h"
+#include "core/hash_table.h"
+
+namespace stonedb {
+namespace core {
+// Hash tables built by ParallelHashJoiner for the traversed side of a join,
+// kept for other queries joining the same filtered dimension on the same key
+// columns. An entry is found by a key describing the table, the key columns
+// with their versions and the encoding, and by the rows put into it (the
+// filter of the dimension). Entries are immutable and evicted in LRU order
+// when their total size exceeds stonedb_sysvar_join_cache_size MB.
+class JoinHashCache final {
+ public:
+  struct Entry {
+    uint32_t table_id = 0;
+    std::string key;
+    std::unique_ptr<Filter> filter;
+    std::vector<std::shared_ptr<HashTable>> hash_tables;
+    std::vector<std::vector<ColumnBinEncoder>> encoders;  // for each hash table, not bound to any column
+    int64_t traversed_rows = 0;
+    int64_t actually_traversed_rows = 0;
+    size_t size = 0;  // in bytes
+  };
+
+  JoinHashCache() = default;
+  ~JoinHashCache() = default;
+
+  static bool Enabled();
+  std::shared_ptr<const Entry> Get(const std::string &key, Filter &filter);
+  void Put(std::shared_ptr<Entry> entry);
+  void ReleaseTable(uint32_t table_id);  // table dropped, truncated or renamed
+  void Shrink();                         // evict down to the current size limit
+  void ReleaseAll();                     // engine shutdown
+
+  int64_t Hits() const { return hits; }
+  int64_t Misses() const { return misses; }
+
+ private:
+  void Evict(size_t limit);
+
+  std::mutex mtx;
+  std::list<std::shared_ptr<Entry>> entries;  // the most recently used first
+  size_t total_size = 0;
+  std::atomic<int64_t> hits{0};
+  std::atomic<int64_t> misses{0};
+};
+}  // namespace core
+}  // namespace stonedb
+
+#endif  // STONEDB_CORE_JOIN_HASH_CACHE_H_
@@ -17,16 +17,34 @@
 
 #include "joiner.h"
 
+#include <sstream>
+#include <thread>
+
 #include "core/joiner_hash.h"
+#include "core/joiner_index.h"
 #include "core/joiner_mapped.h"
 #include "core/joiner_sort.h"
 #include "core/parallel_hash_join.h"
 #include "core/query.h"
+#include "core/transaction.h"
+#include "mm/traceable_object.h"
 #include "vc/const_column.h"
 #include "vc/virtual_column.h"
 
 namespace stonedb {
 namespace core {
+namespace {
+// JoinerParallelMapped splits the probe side into this many packs at least
+const int64_t kParallelMapMinPacks = 4;
+}  // namespace
+
+std::string JoinEstimate::ToString() const {
+  std::stringstream ss;
+  ss << "build " << build_rows << (build_distinct ? " unique" : "") << " rows, probe " << probe_rows
+     << " rows, key span " << key_span << ", " << threads << " threads, " << (memory >> 20) << "MB buffers";
+  return ss.str();
+}
+
 TwoDimensionalJoiner::TwoDimensionalJoiner(MultiIndex *_mind,  // multi-index to be updated
                                            TempTable *_table, JoinTips &_tips)
     : tips(_tips), m_conn(current_tx) {
@@ -39,14 +57,28 @@ TwoDimensionalJoiner::~TwoDimensionalJoiner() {
   // Note that mind and rmind are external pointers
 }
 
-JoinAlgType TwoDimensionalJoiner::ChooseJoinAlgorithm([[maybe_unused]] MultiIndex &mind, Condition &cond) {
+JoinAlgType TwoDimensionalJoiner::ChooseJoinAlgorithm(MultiIndex &mind, Condition &cond, JoinTips &tips) {
   JoinAlgType join_alg = JoinAlgType::JTYPE_GENERAL;
+  tips.parallel_map = false;
 
   if (cond[0].IsType_JoinSimple() && cond[0].op == common::Operator::O_EQ) {
-    if ((cond.Size() == 1) && !stonedb_sysvar_force_hashjoin)
-      join_alg = JoinAlgType::JTYPE_MAP;  // available types checked inside
-    else
-      join_alg = JoinAlgType::JTYPE_HASH;
+    join_alg = JoinAlgType::JTYPE_HASH;
+    if ((cond.Size() == 1) && !stonedb_sysvar_force_hashjoin) {
+      JoinEstimate est = EstimateJoin(mind, cond[0]);
+      // a map is a table of key_span bytes for a unique dense key, or a
+      // multimap otherwise (available types checked inside)
+      bool offset_map = est.build_distinct && OffsetMapFunction::Suitable(est.build_rows, 0, est.key_span - 1) &&
+                        est.key_span <= est.memory;
+      if (est.key_span > 0 && (offset_map || est.build_rows <= kMultiMapMaxRows)) {
+        join_alg = JoinAlgType::JTYPE_MAP;
+        tips.parallel_map = est.threads > 1 && est.probe_sliceable &&
+                            (est.probe_rows >> mind.ValueOfPower()) >= kParallelMapMinPacks;
+      }
+      rccontrol.lock(mind.m_conn->GetThreadID())
+          << "Join algorithm: " << (join_alg == JoinAlgType::JTYPE_MAP ? (tips.parallel_map ? "parallel map" : "map")
+                                                                      : "hash")
+          << " (" << est.ToString() << ")" << system::unlock;
+    }
   } else {
     if (cond[0].IsType_JoinSimple() &&
         (cond[0].op == common::Operator::O_MORE_EQ || cond[0].op == common::Operator::O_MORE ||
@@ -56,6 +88,46 @@ JoinAlgType TwoDimensionalJoiner::ChooseJoinAlgorithm([[maybe_unused]] MultiInde
   return join_alg;
 }
 
+JoinEstimate TwoDimensionalJoiner::EstimateJoin(MultiIndex &mind, Descriptor &desc) {
+  JoinEstimate est;
+  est.threads = stonedb_sysvar_query_threads ? stonedb_sysvar_query_threads : std::thread::hardware_concurrency();
+  est.memory = mm::TraceableObject::MaxBufferSize();
+
+  vcolumn::VirtualColumn *build_vc = desc.attr.vc;
+  vcolumn::VirtualColumn *probe_vc = desc.val1.vc;
+  DimensionVector build_dims(mind.NumOfDimensions());
+  DimensionVector probe_dims(mind.NumOfDimensions());
+  build_vc->MarkUsedDims(build_dims);
+  probe_vc->MarkUsedDims(probe_dims);
+  mind.MarkInvolvedDimGroups(build_dims);
+  mind.MarkInvolvedDimGroups(probe_dims);
+  est.build_rows = mind.NumOfTuples(build_dims, false);
+  est.probe_rows = mind.NumOfTuples(probe_dims, false);
+  // the same choice of sides as in JoinerMapped
+  if ((probe_vc->IsDistinct() && !build_vc->IsDistinct()) || build_dims.NoDimsUsed() > 1 ||
+      est.probe_rows < est.build_rows) {
+    std::swap(build_vc, probe_vc);
+    std::swap(build_dims, probe_dims);
+    std::swap(est.build_rows, est.probe_rows);
+  }
+  est.build_distinct =
+      build_vc->IsDistinct() || (build_vc->GetApproxDistVals(false) >= est.build_rows && !build_vc->IsNullsPossible());
+  est.probe_sliceable = probe_dims.NoDimsUsed() == 1 && mind.GetFilter(probe_dims.GetOneDim()) != nullptr;
+
+  ColumnType build_type = build_vc->Type();
+  ColumnType probe_type = probe_vc->Type();
+  if (build_dims.NoDimsUsed() == 1 && !build_dims.Intersects(probe_dims) && build_type.IsFixed() &&
+      probe_type.IsFixed() && build_type.GetScale() == probe_type.GetScale() && !build_type.IsLookup() &&
+      !probe_type.IsLookup()) {
+    int64_t key_min = build_vc->RoughMin();
+    int64_t key_max = build_vc->RoughMax();
+    if (key_min != common::NULL_VALUE_64 && key_min != common::MINUS_INF_64 && key_max != common::NULL_VALUE_64 &&
+        key_max != common::PLUS_INF_64 && key_max - key_min + 1 > 0)
+      est.key_span = key_max - key_min + 1;
+  }
+  return est;
+}
+
 JoinAlgType TwoDimensionalJoiner::ChooseJoinAlgorithm(JoinFailure join_result, JoinAlgType prev_type,
                                                       [[maybe_unused]] size_t desc_size) {
   if (join_result == JoinFailure::FAIL_1N_TOO_HARD) return JoinAlgType::JTYPE_HASH;
@@ -72,9 +144,12 @@ std::unique_ptr<TwoDimensionalJoiner> TwoDimensionalJoiner::CreateJoiner(JoinAlg
     case JoinAlgType::JTYPE_SORT:
       return std::unique_ptr<TwoDimensionalJoiner>(new JoinerSort(&mind, table, tips));
     case JoinAlgType::JTYPE_MAP:
-      return std::unique_ptr<TwoDimensionalJoiner>(stonedb_sysvar_parallel_mapjoin
-                                                       ? (new JoinerParallelMapped(&mind, table, tips))
-                                                       : (new JoinerMapped(&mind, table, tips)));
+      return std::unique_ptr<TwoDimensionalJoiner>(
+          stonedb_sysvar_parallel_mapjoin || (stonedb_sysvar_join_parallel > 0 && tips.parallel_map)
+              ? (new JoinerParallelMapped(&mind, table, tips))
+              : (new JoinerMapped(&mind, table, tips)));
+    case JoinAlgType::JTYPE_INDEX:
+      return std::unique_ptr<TwoDimensionalJoiner>(new JoinerIndex(&mind, table, tips));
     case JoinAlgType::JTYPE_GENERAL:
       return std::unique_ptr<TwoDimensionalJoiner>(new JoinerGeneral(&mind, table, tips));
     default:
@@ -86,6 +161,7 @@ std::unique_ptr<TwoDimensionalJoiner> TwoDimensionalJoiner::CreateJoiner(JoinAlg
 JoinTips::JoinTips(MultiIndex &mind) {
   limit = -1;
   count_only = false;
+  parallel_map = false;
   for (int i = 0; i < mind.NumOfDimensions(); i++) {
     forget_now.push_back(mind.IsForgotten(i));
     distinct_only.push_back(false);
@@ -99,6 +175,7 @@ JoinTips::JoinTips(const JoinTips &sec) {
   forget_now = sec.forget_now;
   distinct_only = sec.distinct_only;
   null_only = sec.null_only;
+  parallel_map = sec.parallel_map;
 }
 }  // namespace core
 }  // namespace stonedb
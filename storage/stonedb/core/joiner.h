@@ -38,9 +38,27 @@ class JoinTips {
                                     // this dimension
   std::vector<bool> null_only;      // outer nulls only, e.g. "...t1 left join t2 on a=b where
                                     // t2.c is null" (when c is not null by default)
+  bool parallel_map;                // JoinerParallelMapped is worth its threads (set by ChooseJoinAlgorithm())
 };
 
-enum class JoinAlgType { JTYPE_NONE, JTYPE_SORT, JTYPE_HASH, JTYPE_MIXED, JTYPE_MAP, JTYPE_GENERAL };
+// The statistics a join algorithm is chosen by
+struct JoinEstimate {
+  int64_t build_rows = 0;  // the side put into a map or a hash table
+  int64_t probe_rows = 0;
+  int64_t key_span = 0;          // max - min + 1 of the build key, 0 if the keys are not mappable integers
+  bool build_distinct = false;   // the build key is (probably) unique
+  bool probe_sliceable = false;  // the probe side is one filtered dimension, so it may be split by packs
+  int threads = 1;
+  int64_t memory = 0;  // bytes available for a large buffer
+
+  std::string ToString() const;
+};
+
+// Up to this many build rows a multimap is built and probed about as fast as
+// a hash table; for more rows only a dense unique key (offset map) is faster
+constexpr int64_t kMultiMapMaxRows = 65536;
+
+enum class JoinAlgType { JTYPE_NONE, JTYPE_SORT, JTYPE_HASH, JTYPE_MIXED, JTYPE_MAP, JTYPE_INDEX, JTYPE_GENERAL };
 // MIXED   - for reporting: more than one algorithm was used
 
 class TwoDimensionalJoiner {  // abstract class for multiindex-based join
@@ -67,7 +85,10 @@ class TwoDimensionalJoiner {  // abstract class for multiindex-based join
   JoinFailure WhyFailed() { return why_failed; }
   // the reason of the last failure of join operation
  public:
-  static JoinAlgType ChooseJoinAlgorithm(MultiIndex &mind, Condition &desc);
+  // Choose by the estimated cardinalities and key density of both sides; also
+  // decides tips.parallel_map
+  static JoinAlgType ChooseJoinAlgorithm(MultiIndex &mind, Condition &desc, JoinTips &tips);
+  static JoinEstimate EstimateJoin(MultiIndex &mind, Descriptor &desc);
   static JoinAlgType ChooseJoinAlgorithm(JoinFailure join_result, JoinAlgType prev_type, size_t desc_size);
   static std::unique_ptr<TwoDimensionalJoiner> CreateJoiner(JoinAlgType join_alg_type, MultiIndex &mind,
                                                             JoinTips &_tips, TempTable *table);
@@ -0,0 +1,155 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+
+#include "joiner_index.h"
+
+#include "common/common_definitions.h"
+#include "core/engine.h"
+#include "core/mi_new_contents.h"
+#include "core/rc_attr.h"
+#include "core/transaction.h"
+#include "index/rc_table_index.h"
+#include "vc/single_column.h"
+#include "vc/virtual_column.h"
+
+namespace stonedb {
+namespace core {
+JoinerIndex::JoinerIndex(MultiIndex *_mind, TempTable *_table, JoinTips &_tips)
+    : TwoDimensionalJoiner(_mind, _table, _tips) {
+  traversed_dims = DimensionVector(_mind->NumOfDimensions());
+  matched_dims = DimensionVector(_mind->NumOfDimensions());
+}
+
+std::shared_ptr<index::RCTableIndex> JoinerIndex::KeyIndex(vcolumn::VirtualColumn *vc) {
+  if (vc->IsSingleColumn() != vcolumn::VirtualColumn::single_col_t::SC_RCATTR || !vc->Type().IsFixed() ||
+      vc->Type().IsLookup())
+    return nullptr;
+  return static_cast<RCAttr *>(static_cast<vcolumn::SingleColumn *>(vc)->GetPhysical())->GetKeyIndex();
+}
+
+void JoinerIndex::ExecuteJoinConditions(Condition &cond) {
+  MEASURE_FET("JoinerIndex::ExecuteJoinConditions(...)");
+
+  why_failed = JoinFailure::FAIL_1N_TOO_HARD;
+  auto &desc(cond[0]);
+  if (cond.Size() > 1 || !desc.IsType_JoinSimple() || desc.op != common::Operator::O_EQ || !desc.right_dims.IsEmpty())
+    return;
+
+  if (!KeyIndex(desc.attr.vc) && KeyIndex(desc.val1.vc)) desc.SwitchSides();  // the indexed side is "traversed"
+  auto indextab = KeyIndex(desc.attr.vc);
+  if (!indextab) return;
+
+  vcolumn::VirtualColumn *vc1 = desc.attr.vc;
+  vcolumn::VirtualColumn *vc2 = desc.val1.vc;
+  if (!vc2->Type().IsFixed() || vc1->Type().GetScale() != vc2->Type().GetScale() || vc2->Type().IsLookup()) return;
+
+  vc1->MarkUsedDims(traversed_dims);
+  vc2->MarkUsedDims(matched_dims);
+  mind->MarkInvolvedDimGroups(traversed_dims);
+  mind->MarkInvolvedDimGroups(matched_dims);
+  if (traversed_dims.Intersects(matched_dims) || traversed_dims.NoDimsUsed() > 1) return;
+  traversed_dim = vc1->GetDim();
+  Filter *filter = mind->GetFilter(traversed_dim);
+  if (!filter) return;  // materialized dimension: rows found cannot be checked
+
+  for (int i = 0; i < mind->NumOfDimensions(); i++)
+    if (matched_dims[i]) matched_dim_list.push_back(i);
+
+  MIIterator mit(mind, matched_dims);
+  uint64_t dim2_size = mit.NumOfTuples();
+
+  mind->LockAllForUse();
+  MINewContents new_mind(mind, tips);
+  new_mind.SetDimensions(traversed_dims);
+  new_mind.SetDimensions(matched_dims);
+  if (!tips.count_only) new_mind.Init(dim2_size);  // primary key: at most one row for every key
+
+  // Matching loop itself
+  keys.reserve(BATCH_SIZE);
+  tuples.reserve(BATCH_SIZE * matched_dim_list.size());
+  int64_t joined_tuples = 0;
+  int64_t lookups = 0;
+  bool index_ok = true;
+  while (mit.IsValid() && index_ok) {
+    if (mit.PackrowStarted()) {
+      if (m_conn->Killed()) throw common::KilledException();
+      if (vc2->GetNumOfNulls(mit) == mit.GetPackSizeLeft()) {  // nulls are never joined
+        mit.NextPackrow();
+        continue;
+      }
+      vc2->LockSourcePacks(mit);
+    }
+    if (!vc2->IsNull(mit)) {
+      keys.push_back(vc2->GetNotNullValueInt64(mit));
+      for (int dim : matched_dim_list) tuples.push_back(mit[dim]);
+      if (keys.size() == BATCH_SIZE) {
+        lookups += keys.size();
+        index_ok = ProbeBatch(*indextab, *filter, new_mind, joined_tuples);
+      }
+    }
+    if (tips.limit != -1 && tips.limit <= joined_tuples) break;
+    ++mit;
+  }
+  if (index_ok && !keys.empty() && (tips.limit == -1 || tips.limit > joined_tuples)) {
+    lookups += keys.size();
+    index_ok = ProbeBatch(*indextab, *filter, new_mind, joined_tuples);
+  }
+  vc2->UnlockSourcePacks();
+
+  if (!index_ok) {  // nothing committed yet, another algorithm will do the join
+    STONEDB_LOG(LogCtl_Level::WARN, "Primary key index lookup failed, join falls back to another algorithm.");
+    mind->UnlockAllFromUse();
+    return;
+  }
+
+  // Cleaning up
+  rccontrol.lock(m_conn->GetThreadID()) << "Index lookups: " << lookups << ", produced " << joined_tuples
+                                        << " tuples." << system::unlock;
+  if (tips.count_only)
+    new_mind.CommitCountOnly(joined_tuples);
+  else
+    new_mind.Commit(joined_tuples);
+
+  mind->UnlockAllFromUse();
+  why_failed = JoinFailure::NOT_FAILED;
+}
+
+bool JoinerIndex::ProbeBatch(index::RCTableIndex &indextab, Filter &filter, MINewContents &new_mind,
+                             int64_t &joined_tuples) {
+  std::vector<std::string_view> fields;
+  fields.reserve(keys.size());
+  for (auto &key : keys) fields.emplace_back((const char *)&key, sizeof(int64_t));
+  if (indextab.GetRowsByKeys(m_conn, fields, rows) != common::ErrorCode::SUCCESS) return false;
+
+  size_t no_dims = matched_dim_list.size();
+  for (size_t i = 0; i < keys.size(); i++) {
+    // the row may be filtered out of the traversed dimension already
+    if (rows[i] == common::NULL_VALUE_64 || rows[i] >= filter.NumOfObj() || !filter.Get(rows[i])) continue;
+    joined_tuples++;
+    if (!tips.count_only) {
+      for (size_t d = 0; d < no_dims; d++) new_mind.SetNewTableValue(matched_dim_list[d], tuples[i * no_dims + d]);
+      new_mind.SetNewTableValue(traversed_dim, rows[i]);
+      new_mind.CommitNewTableValues();
+    }
+    if (tips.limit != -1 && tips.limit <= joined_tuples) break;
+  }
+  keys.clear();
+  tuples.clear();
+  return true;
+}
+}  // namespace core
+}  // namespace stonedb
@@ -0,0 +1,75 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+#ifndef STONEDB_CORE_JOINER_INDEX_H_
+#define STONEDB_CORE_JOINER_INDEX_H_
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/joiner.h"
+
+namespace stonedb {
+namespace index {
+class RCTableIndex;
+}  // namespace index
+namespace core {
+class MINewContents;
+
+class JoinerIndex : public TwoDimensionalJoiner {
+  /*
+   * Index nested-loop join: the "traversed" side is not scanned at all, the
+   * key values of the "matched" side are looked up in the primary key index of
+   * the traversed table instead. Meant for a small matched side joined with a
+   * big table on its primary key. Assumptions: one equality condition, inner
+   * join, the traversed side is a column being the one-column primary key of
+   * its table, fixed point values on both sides.
+   *
+   * Algorithm:
+   * 1. scan the "matched" dimensions, collect a batch of key values together
+   * with the current tuples,
+   * 2. look up the whole batch in the index (one MultiGet),
+   * 3. submit the tuples whose row found is present in the traversed dimension,
+   * 4. repeat until the matched dimensions are exhausted.
+   */
+ public:
+  JoinerIndex(MultiIndex *_mind, TempTable *_table, JoinTips &_tips);
+
+  void ExecuteJoinConditions(Condition &cond) override;
+
+  // the primary key index usable for joining on vc, nullptr if there is none
+  static std::shared_ptr<index::RCTableIndex> KeyIndex(vcolumn::VirtualColumn *vc);
+
+ private:
+  static constexpr size_t BATCH_SIZE = 1024;  // keys looked up in one MultiGet
+
+  // look up the collected keys and submit the joined tuples; false if the index failed
+  bool ProbeBatch(index::RCTableIndex &indextab, Filter &filter, MINewContents &new_mind, int64_t &joined_tuples);
+
+  DimensionVector traversed_dims;  // the dimension of the indexed column
+  DimensionVector matched_dims;    // the dimensions scanned for the keys
+  int traversed_dim = -1;
+  std::vector<int> matched_dim_list;
+
+  std::vector<int64_t> keys;    // the current batch of keys
+  std::vector<int64_t> tuples;  // the matched dimensions values for every key
+  std::vector<int64_t> rows;    // rows found in the index for every key
+};
+}  // namespace core
+}  // namespace stonedb
+
+#endif  // STONEDB_CORE_JOINER_INDEX_H_
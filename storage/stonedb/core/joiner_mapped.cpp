@@ -204,6 +204,21 @@ void JoinerMapped::ExecuteJoinConditions(Condition &cond) {
 
 std::unique_ptr<JoinerMapFunction> JoinerMapped::GenerateFunction(vcolumn::VirtualColumn *vc) {
   MIIterator mit(mind, traversed_dims);
+  if (OffsetMapFunction::Suitable(mit.NumOfTuples(), vc->RoughMin(), vc->RoughMax())) {
+    auto offset_function = std::make_unique<OffsetMapFunction>(m_conn);
+    if (offset_function->Init(vc, mit)) {
+      rccontrol.lock(m_conn->GetThreadID())
+          << "Join mapping (offsets) created on " << mit.NumOfTuples() << " rows." << system::unlock;
+      return std::move(offset_function);
+    }
+    mit.Rewind();  // repeated keys or too many offsets
+  }
+  if (mit.NumOfTuples() > kMultiMapMaxRows) {
+    // a multimap of that many rows is slower than a hash join
+    rccontrol.lock(m_conn->GetThreadID()) << "Join mapping abandoned on " << mit.NumOfTuples() << " rows."
+                                          << system::unlock;
+    return nullptr;
+  }
   auto map_function = std::make_unique<MultiMapsFunction>(m_conn);
   if (!map_function->Init(vc, mit)) return nullptr;
 
@@ -234,8 +249,8 @@ int64_t JoinerParallelMapped::ExecuteMatchLoop(std::shared_ptr<MultiIndexBuilder
   int64_t packrows_omitted = 0;
   int64_t packrows_matched = 0;
   int traversed_dim = traversed_dims.GetOneDim();
-  int32_t i = task.dwStartPackno;
-  while (i < task.dwEndPackno) {
+  for (int32_t i = task.dwStartPackno; i < task.dwEndPackno; i++) {
+    // the iterator stops at the end of this packrow
     mit.SetNoPacksToGo(packrows[i]);
     mit.RewindToPack(packrows[i]);
     // for all non-matching dimension values
@@ -274,8 +289,8 @@ int64_t JoinerParallelMapped::ExecuteMatchLoop(std::shared_ptr<MultiIndexBuilder
           for (auto rownum : rownums) {
             joined_tuples++;
             if (tips.count_only) continue;
-            for (int i = 0; i < mind->NumOfDimensions(); i++)
-              if (matched_dims[i]) (*indextable)->SetTableValue(i, mit[i]);
+            for (int dim = 0; dim < mind->NumOfDimensions(); dim++)
+              if (matched_dims[dim]) (*indextable)->SetTableValue(dim, mit[dim]);
             (*indextable)->SetTableValue(traversed_dim, rownum);
             (*indextable)->CommitTableValues();
           }
@@ -283,8 +298,8 @@ int64_t JoinerParallelMapped::ExecuteMatchLoop(std::shared_ptr<MultiIndexBuilder
       } else if (outer_join) {
         joined_tuples++;
         if (!tips.count_only) {
-          for (int i = 0; i < mind->NumOfDimensions(); i++)
-            if (matched_dims[i]) (*indextable)->SetTableValue(i, mit[i]);
+          for (int dim = 0; dim < mind->NumOfDimensions(); dim++)
+            if (matched_dims[dim]) (*indextable)->SetTableValue(dim, mit[dim]);
           (*indextable)->SetTableValue(traversed_dim, common::NULL_VALUE_64);
           (*indextable)->CommitTableValues();
         }
@@ -292,6 +307,7 @@ int64_t JoinerParallelMapped::ExecuteMatchLoop(std::shared_ptr<MultiIndexBuilder
       if (tips.limit != -1 && tips.limit <= joined_tuples) break;
       ++mit;
     }
+    if (tips.limit != -1 && tips.limit <= joined_tuples) break;
   }
 
   if (packrows_omitted > 0)
@@ -423,6 +439,14 @@ void OffsetMapFunction::Fetch(int64_t key_val, std::vector<int64_t> &keys_value)
   return;  // Offset map has one unique key
 }
 
+bool OffsetMapFunction::Suitable(int64_t rows, int64_t key_min, int64_t key_max) {
+  if (key_min == common::NULL_VALUE_64 || key_min == common::MINUS_INF_64 || key_max == common::PLUS_INF_64 ||
+      key_max == common::NULL_VALUE_64)
+    return false;
+  int64_t span = key_max - key_min + 1;
+  return span > 0 && size_t(span) <= 32_MB && span <= 2 * rows;
+}
+
 bool OffsetMapFunction::Init(vcolumn::VirtualColumn *vc, MIIterator &mit) {
   int dim = vc->GetDim();
   if (dim == -1) return false;
@@ -98,6 +98,9 @@ class OffsetMapFunction : public JoinerMapFunction {
   OffsetMapFunction(Transaction *_m_conn) : JoinerMapFunction(_m_conn) {}
   ~OffsetMapFunction() = default;
 
+  // true if a unique key of 'rows' values between key_min and key_max is
+  // dense enough for a table of (key_max - key_min + 1) bytes
+  static bool Suitable(int64_t rows, int64_t key_min, int64_t key_max);
   bool Init(vcolumn::VirtualColumn *vc, MIIterator &mit);
 
   void Fetch(int64_t key_val, std::vector<int64_t> &row_nums) override;
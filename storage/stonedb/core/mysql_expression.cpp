@@ -109,6 +109,8 @@ bool MysqlExpression::SanityAggregationCheck(Item *item, std::set<Item *> &field
       return true;
     case Item::FUNC_ITEM: {
       if (dynamic_cast<Item_func_trig_cond *>(item) != NULL) return false;
+      // analytic functions are computed on the materialized rows, see Query::AddWindowColumn()
+      if (dynamic_cast<Item_func_sdb_window *>(item) != NULL) return false;
 
       // currently stored procedures not supported
       if (dynamic_cast<Item_func_sp *>(item) != NULL) {
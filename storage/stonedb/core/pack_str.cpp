@@ -689,6 +689,116 @@ void PackStr::LoadUncompressed(system::Stream *f) {
   ASSERT(data.sum_len == sz, "bad pack! " + std::to_string(data.sum_len) + "/" + std::to_string(sz));
 }
 
+bool PackStr::ProjectsPrefix(const DPN &dpn, ColumnShare *s) {
+  return dpn.NullOnly() || (!dpn.no_compress && s->ColType().GetFmt() == common::PackFmt::TRIE);
+}
+
+void PackStr::LoadProjection(const DPN &dpn, ColumnShare *s, uint32_t *nulls, uint32_t *lens,
+                             const types::BString *prefix, uint32_t *matches) {
+  DEBUG_ASSERT(!prefix || ProjectsPrefix(dpn, s));
+  size_t nulls_size = (1 << s->pss) / 8;
+  std::memset(nulls, 0, nulls_size);
+  if (lens) std::memset(lens, 0, sizeof(uint32_t) * dpn.nr);
+  if (prefix) std::memset(matches, 0, nulls_size);
+  if (dpn.NullOnly()) {
+    for (uint i = 0; i < dpn.nr; i++) nulls[i >> 5] |= (uint32_t(1) << (i % 32));
+    return;
+  }
+
+  system::StoneDBFile f;
+  f.OpenReadOnly(s->DataFile());
+  f.Seek(dpn.addr, SEEK_SET);
+
+  if (dpn.no_compress) {
+    // the flat null mask and the length array precede the values
+    f.ReadExact(nulls, nulls_size);
+    if (lens) {
+      auto t = s->ColType().GetTypeName();
+      if (t == common::CT::BIN || t == common::CT::LONGTEXT) {
+        f.ReadExact(lens, sizeof(uint32_t) * dpn.nr);
+      } else {
+        std::unique_ptr<uint16_t[]> lens16(new uint16_t[dpn.nr]);
+        f.ReadExact(lens16.get(), sizeof(uint16_t) * dpn.nr);
+        for (uint i = 0; i < dpn.nr; i++) lens[i] = lens16[i];
+      }
+    }
+    return;
+  }
+
+  if (s->ColType().GetFmt() == common::PackFmt::TRIE) {
+    // the trie is followed by the total length and the key id of every row
+    // (0xffff for nulls)
+    auto trie_length = dpn.len - (dpn.nr * sizeof(unsigned short)) - 8;
+    std::unique_ptr<char[]> buf;
+    unsigned short *ids;
+    marisa::Trie trie;
+    if (lens || prefix) {
+      buf.reset(new char[dpn.len]);
+      f.ReadExact(buf.get(), dpn.len);
+      trie.map(buf.get(), trie_length);
+      ids = (unsigned short *)(buf.get() + trie_length + 8);
+    } else {
+      buf.reset(new char[dpn.nr * sizeof(unsigned short)]);
+      f.Seek(dpn.addr + trie_length + 8, SEEK_SET);
+      f.ReadExact(buf.get(), dpn.nr * sizeof(unsigned short));
+      ids = (unsigned short *)buf.get();
+    }
+    marisa::Agent agent;
+    std::vector<char> prefix_ids;  // the key ids starting with the prefix
+    if (prefix) {
+      prefix_ids.resize(trie.num_keys(), 0);
+      agent.set_query(prefix->GetDataBytesPointer(), prefix->size());
+      while (trie.predictive_search(agent)) prefix_ids[agent.key().id()] = 1;
+    }
+    for (uint row = 0; row < dpn.nr; row++) {
+      if (ids[row] == 0xffff) {
+        nulls[row >> 5] |= (uint32_t(1) << (row % 32));
+        continue;
+      }
+      if (lens) {
+        agent.set_query(std::size_t(ids[row]));
+        trie.reverse_lookup(agent);
+        lens[row] = agent.key().length();
+      }
+      if (prefix && prefix_ids[ids[row]]) matches[row >> 5] |= (uint32_t(1) << (row % 32));
+    }
+    return;
+  }
+
+  if (dpn.nn > 0) {
+    ushort null_buf_size;
+    f.ReadExact(&null_buf_size, sizeof(null_buf_size));
+    if (!dpn.null_compressed) {  // flat null encoding
+      f.ReadExact(nulls, null_buf_size);
+    } else {
+      std::unique_ptr<char[]> null_buf(new char[null_buf_size]);
+      f.ReadExact(null_buf.get(), null_buf_size);
+      compress::BitstreamCompressor bsc;
+      CprsErr res = bsc.Decompress((char *)nulls, null_buf_size, null_buf.get(), dpn.nr, dpn.nn);
+      if (res != CprsErr::CPRS_SUCCESS) {
+        throw common::DatabaseException("Decompression of nulls failed for column " + s->DataFile() + " (error " +
+                                        std::to_string(static_cast<int>(res)) + ").");
+      }
+    }
+  }
+  if (!lens) return;
+
+  uint32_t len_header[2];  // the size of the length section and the maximal length
+  f.ReadExact(len_header, sizeof(len_header));
+  if (len_header[1] == 0) return;
+  std::unique_ptr<char[]> len_buf(new char[len_header[0] - 8]);
+  f.ReadExact(len_buf.get(), len_header[0] - 8);
+  std::unique_ptr<uint[]> cn(new uint[1 << s->pss]);
+  compress::NumCompressor<uint> nc;
+  CprsErr res = nc.Decompress(cn.get(), len_buf.get(), len_header[0] - 8, dpn.nr - dpn.nn, len_header[1]);
+  if (res != CprsErr::CPRS_SUCCESS) {
+    throw common::DatabaseException("Decompression of lengths of std::string values failed for column " +
+                                    s->DataFile() + " (error " + std::to_string(static_cast<int>(res)) + ").");
+  }
+  for (uint row = 0, oid = 0; row < dpn.nr; row++)
+    if ((nulls[row >> 5] & (uint32_t(1) << (row % 32))) == 0) lens[row] = cn[oid++];
+}
+
 bool PackStr::Lookup(const types::BString &pattern, uint16_t &id) {
   marisa::Agent agent;
   agent.set_query(pattern.GetDataBytesPointer(), pattern.size());
@@ -54,6 +54,15 @@ class PackStr final : public Pack {
   bool IsNotMatched(int row, uint16_t &id);
   bool IsNotMatched(int row, const std::unordered_set<uint16_t> &ids);
 
+  // Decode only the null mask (and the value lengths, if 'lens' is not null)
+  // of a pack stored on disk, leaving the values themselves compressed.
+  // 'nulls' is laid out as Pack::nulls, 'lens' has one entry per row.
+  // 'matches' is a mask of the rows starting with 'prefix'; only a compressed
+  // TRIE pack can give it, from the trie keys.
+  static void LoadProjection(const DPN &dpn, ColumnShare *s, uint32_t *nulls, uint32_t *lens,
+                             const types::BString *prefix = nullptr, uint32_t *matches = nullptr);
+  static bool ProjectsPrefix(const DPN &dpn, ColumnShare *s);
+
  protected:
   std::pair<UniquePtr, size_t> Compress() override;
   void CompressTrie();
@@ -15,6 +15,7 @@
    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
 */
 
+#include <algorithm>
 #include <list>
 
 #include "common/assert.h"
@@ -23,11 +24,13 @@
 #include "core/joiner_hash.h"
 #include "core/parallel_hash_join.h"
 #include "core/proxy_hash_joiner.h"
+#include "core/rc_attr.h"
 #include "core/task_executor.h"
 #include "core/temp_table.h"
 #include "core/transaction.h"
 #include "system/fet.h"
 #include "util/thread_pool.h"
+#include "vc/single_column.h"
 #include "vc/virtual_column.h"
 
 namespace stonedb {
@@ -470,6 +473,27 @@ void ParallelHashJoiner::ExecuteJoin() {
 }
 
 int64_t ParallelHashJoiner::TraverseDim(MIIterator &mit, int64_t *outer_tuples) {
+  Filter *cache_filter = nullptr;
+  uint32_t cache_table_id = 0;
+  std::string cache_key = HashCacheKey(&cache_filter, &cache_table_id);
+  if (!cache_key.empty()) {
+    if (auto entry = rceng->join_hash_cache.Get(cache_key, *cache_filter)) {
+      traversed_hash_tables_.reserve(entry->hash_tables.size());
+      for (size_t i = 0; i < entry->hash_tables.size(); ++i) {
+        auto &ht = traversed_hash_tables_.emplace_back(hash_table_key_size_, hash_table_tuple_size_, 0, pack_power_,
+                                                       watch_traversed_);
+        ht.Share(entry->hash_tables[i]);
+        std::vector<ColumnBinEncoder> column_bin_encoder(entry->encoders[i]);
+        for (int index = 0; index < cond_hashed_; ++index) column_bin_encoder[index].SetColumn(vc1_[index]);
+        ht.AssignColumnEncoder(column_bin_encoder);
+      }
+      actually_traversed_rows_ += entry->actually_traversed_rows;
+      rccontrol.lock(m_conn->GetThreadID()) << "Reused hash tables of " << entry->traversed_rows
+                                            << " traversed rows built by another query." << system::unlock;
+      return entry->traversed_rows;
+    }
+  }
+
   int64_t rows_count = mind->NumOfTuples(traversed_dims_);
   int availabled_packs = (int)((rows_count + (1 << pack_power_) - 1) >> pack_power_);
 
@@ -586,9 +610,58 @@ int64_t ParallelHashJoiner::TraverseDim(MIIterator &mit, int64_t *outer_tuples)
     vc1_[index]->UnlockSourcePacks();
   }
 
+  bool complete = std::none_of(traverse_task_params.begin(), traverse_task_params.end(),
+                               [](const TraverseTaskParams &p) { return p.too_many_conflicts || p.no_space_left; });
+  if (!cache_key.empty() && complete) {
+    auto entry = std::make_shared<JoinHashCache::Entry>();
+    entry->table_id = cache_table_id;
+    entry->key = std::move(cache_key);
+    entry->filter.reset(new Filter(*cache_filter));
+    for (auto &ht : traversed_hash_tables_) {
+      entry->hash_tables.push_back(ht.shared_hash_table());
+      entry->size += ht.hash_table()->GetMemorySize();
+      auto &column_bin_encoder = entry->encoders.emplace_back();
+      ht.GetColumnEncoder(&column_bin_encoder);
+      for (auto &encoder : column_bin_encoder) encoder.SetColumn(nullptr);
+    }
+    entry->traversed_rows = traversed_rows;
+    entry->actually_traversed_rows = actually_traversed_rows_;
+    rceng->join_hash_cache.Put(std::move(entry));
+  }
+
   return traversed_rows;
 }
 
+std::string ParallelHashJoiner::HashCacheKey(Filter **filter, uint32_t *table_id) {
+  if (!JoinHashCache::Enabled() || watch_traversed_) return "";
+  // only a single table is identified by its filter
+  int dim = -1;
+  for (int index = 0; index < mind->NumOfDimensions(); ++index) {
+    if (!traversed_dims_[index]) continue;
+    if (dim != -1) return "";
+    dim = index;
+  }
+  if (dim == -1 || (*filter = mind->GetFilter(dim)) == nullptr) return "";
+
+  std::string key;
+  for (int index = 0; index < cond_hashed_; ++index) {
+    if (vc1_[index]->IsSingleColumn() != vcolumn::VirtualColumn::single_col_t::SC_RCATTR ||
+        vc1_[index]->GetDim() != dim)
+      return "";
+    auto col = static_cast<RCAttr *>(static_cast<vcolumn::SingleColumn *>(vc1_[index])->GetPhysical());
+    if (col->IsChanged()) return "";  // not visible to other transactions
+    *table_id = uint32_t(col->TableId());
+    key += std::to_string(col->ColId()) + "@" + col->GetVersion().ToString() + ",";
+  }
+  key = std::to_string(*table_id) + ":" + key + std::to_string(pack_power_) + ":";
+  for (int size : hash_table_key_size_) key += std::to_string(size) + ",";
+  for (int size : hash_table_tuple_size_) key += std::to_string(size) + ",";
+  key += "|";
+  for (auto &encoder : column_bin_encoder_)
+    if (!encoder.GetFingerprint(key)) return "";
+  return key;
+}
+
 int64_t ParallelHashJoiner::AsyncTraverseDim(TraverseTaskParams *params) {
   params->traversed_hash_table->Initialize();
 
@@ -83,6 +83,8 @@ class TraversedHashTable {
   void Initialize();
 
   HashTable *hash_table() const { return hash_table_.get(); }
+  std::shared_ptr<HashTable> shared_hash_table() const { return hash_table_; }
+  void Share(std::shared_ptr<HashTable> hash_table) { hash_table_ = std::move(hash_table); }  // instead of Initialize()
   MutexFilter *outer_filter() const { return outer_filter_.get(); }
   void AssignColumnEncoder(const std::vector<ColumnBinEncoder> &column_bin_encoder);
   void GetColumnEncoder(std::vector<ColumnBinEncoder> *column_bin_encoder);
@@ -93,7 +95,7 @@ class TraversedHashTable {
   std::vector<int> tuples_length_;
   int64_t max_table_size_ = 2;
   uint32_t pack_power_ = 0;
-  std::unique_ptr<HashTable> hash_table_;
+  std::shared_ptr<HashTable> hash_table_;
   bool watch_traversed_ = false;
   std::unique_ptr<MutexFilter> outer_filter_;
   std::vector<ColumnBinEncoder> column_bin_encoder_;
@@ -152,6 +154,9 @@ class ParallelHashJoiner : public TwoDimensionalJoiner {
   bool PrepareBeforeJoin(Condition &cond);
   bool AddKeyColumn(vcolumn::VirtualColumn *vc, vcolumn::VirtualColumn *vc_matching);
   int64_t TraverseDim(MIIterator &mit, int64_t *outer_tuples);
+  // The key of the traversed hash tables in rceng->join_hash_cache, empty if
+  // they are not to be shared with other queries
+  std::string HashCacheKey(Filter **filter, uint32_t *table_id);
   int64_t MatchDim(MIIterator &mit);
   int64_t AsyncTraverseDim(TraverseTaskParams *params);
   int64_t AsyncMatchDim(MatchTaskParams *params);
@@ -20,10 +20,12 @@
 #include "core/condition_encoder.h"
 #include "core/engine.h"
 #include "core/joiner.h"
+#include "core/joiner_index.h"
 #include "core/mi_iterator.h"
 #include "core/mi_updating_iterator.h"
 #include "core/pack_orderer.h"
 #include "core/query.h"
+#include "core/rc_table.h"
 #include "core/rough_multi_index.h"
 #include "core/temp_table.h"
 #include "core/transaction.h"
@@ -302,6 +304,7 @@ bool ParameterizedFilter::RoughUpdateMultiIndex() {
                                                         // roughly trivial leaf
       }
     }
+    if (is_nonempty) is_nonempty = RoughUpdateMultiColumnIndexes();
   }
 
   // Recalculate all multidimensional dependencies only if there are 1-dim
@@ -338,6 +341,78 @@ bool ParameterizedFilter::RoughUpdateMultiIndex() {
   return is_nonempty;
 }
 
+// Equalities with constants on all columns of a ROUGH_INDEX(a,b,...) are
+// checked together against its bloom filter of value tuples. The packs
+// excluded are marked in the rough filter of one of the descriptors, which is
+// correct as the descriptors are a conjunction.
+bool ParameterizedFilter::RoughUpdateMultiColumnIndexes() {
+  struct EqValue {
+    int desc;
+    std::string key;  // the value encoded by RSIndex_Multi::AppendKey()
+  };
+  std::map<std::pair<int, int>, EqValue> eq_values;  // (dim, column) -> value
+  std::map<int, RCTable *> tables;                   // dim -> table
+
+  MIIterator const mit(NULL, mind->ValueOfPower());
+  for (uint i = 0; i < descriptors.Size(); i++) {
+    Descriptor &d = descriptors[i];
+    if (d.done || d.IsDelayed() || !d.IsInner() || d.GetJoinType() != DescriptorJoinType::DT_NON_JOIN || !d.encoded ||
+        d.sharp || d.op != common::Operator::O_BETWEEN || !d.val1.vc || !d.val2.vc || !d.val1.vc->IsConst() ||
+        !d.val2.vc->IsConst() || d.attr.vc->IsSingleColumn() != vcolumn::VirtualColumn::single_col_t::SC_RCATTR)
+      continue;
+    auto sc = static_cast<vcolumn::SingleColumn *>(d.attr.vc);
+    auto &vm = sc->GetVarMap()[0];
+    auto tab = vm.GetTabPtr();
+    if (!tab || tab->TableType() != TType::TABLE || sc->GetDim() == -1) continue;
+
+    EqValue eq{int(i), ""};
+    if (static_cast<RCAttr *>(sc->GetPhysical())->GetPackType() == common::PackType::STR) {
+      if (types::RequiresUTFConversions(d.GetCollation())) continue;
+      types::BString v1, v2;
+      d.val1.vc->GetValueString(v1, mit);
+      d.val2.vc->GetValueString(v2, mit);
+      if (v1.IsNull() || v2.IsNull() || !(v1 == v2)) continue;
+      RSIndex_Multi::AppendKey(eq.key, v1.val, v1.len);
+    } else {
+      int64_t v1 = d.val1.vc->GetValueInt64(mit);
+      int64_t v2 = d.val2.vc->GetValueInt64(mit);
+      if (v1 != v2 || v1 == common::NULL_VALUE_64 || v1 == common::PLUS_INF_64 || v1 == common::MINUS_INF_64) continue;
+      RSIndex_Multi::AppendKey(eq.key, v1);
+    }
+    eq_values.emplace(std::make_pair(sc->GetDim(), vm.col_ndx), eq);
+    tables[sc->GetDim()] = static_cast<RCTable *>(tab.get());
+  }
+
+  bool is_nonempty = true;
+  for (auto &[dim, tab] : tables) {
+    auto &defs = tab->GetMultiIndexDefs();
+    for (size_t n = 0; n < defs.size(); n++) {
+      if (defs[n].kind != MultiIndexDef::Kind::BLOOM) continue;
+      std::string key;
+      int desc = -1;
+      for (auto c : defs[n].cols) {
+        auto it = eq_values.find(std::make_pair(dim, int(c)));
+        if (it == eq_values.end()) {
+          desc = -1;
+          break;
+        }
+        key += it->second.key;
+        if (desc == -1) desc = it->second.desc;
+      }
+      if (desc == -1) continue;
+      auto idx = tab->GetMultiIndex(n);
+      if (!idx) continue;
+
+      common::RSValue *rf = rough_mind->GetLocalDescFilter(dim, desc);
+      for (int p = 0; p < rough_mind->NoPacks(dim); p++)
+        if (rf[p] != common::RSValue::RS_NONE && idx->IsValue(key, p) == common::RSValue::RS_NONE)
+          rf[p] = common::RSValue::RS_NONE;
+      is_nonempty = rough_mind->UpdateGlobalRoughFilter(dim, desc) && is_nonempty;
+    }
+  }
+  return is_nonempty;
+}
+
 bool ParameterizedFilter::PropagateRoughToMind() {
   MEASURE_FET("ParameterizedFilter::PropagateRoughToMind(...)");
   bool is_nonempty = true;
@@ -572,7 +647,9 @@ void ParameterizedFilter::UpdateJoinCondition(Condition &cond, JoinTips &tips)
   int conditions_used = cond.Size();
   JoinAlgType join_alg = JoinAlgType::JTYPE_NONE;
   TwoDimensionalJoiner::JoinFailure join_result = TwoDimensionalJoiner::JoinFailure::NOT_FAILED;
-  join_alg = TwoDimensionalJoiner::ChooseJoinAlgorithm(*mind, cond);
+  join_alg = TwoDimensionalJoiner::ChooseJoinAlgorithm(*mind, cond, tips);
+  if ((join_alg == JoinAlgType::JTYPE_MAP || join_alg == JoinAlgType::JTYPE_HASH) && IndexJoinPreferred(cond))
+    join_alg = JoinAlgType::JTYPE_INDEX;
 
   // Joining itself
   do {
@@ -594,6 +671,28 @@ void ParameterizedFilter::UpdateJoinCondition(Condition &cond, JoinTips &tips)
   DisplayJoinResults(all_involved_dims, join_alg, is_outer, conditions_used);
 }
 
+bool ParameterizedFilter::IndexJoinPreferred(Condition &cond) {
+  // A lookup in the primary key index costs roughly as much as scanning and
+  // hashing this many rows of the indexed side
+  const int64_t lookup_cost = 16;
+
+  if (stonedb_sysvar_index_join_max_rows == 0 || cond.Size() > 1) return false;
+  Descriptor &desc = cond[0];
+  if (!desc.IsType_JoinSimple() || desc.op != common::Operator::O_EQ || !desc.right_dims.IsEmpty()) return false;
+  vcolumn::VirtualColumn *key_vc = desc.attr.vc;
+  vcolumn::VirtualColumn *probe_vc = desc.val1.vc;
+  if (!JoinerIndex::KeyIndex(key_vc)) std::swap(key_vc, probe_vc);
+  if (!JoinerIndex::KeyIndex(key_vc) || !mind->GetFilter(key_vc->GetDim())) return false;
+
+  DimensionVector probe_dims(mind->NumOfDimensions());
+  probe_vc->MarkUsedDims(probe_dims);
+  mind->MarkInvolvedDimGroups(probe_dims);
+  if (probe_dims[key_vc->GetDim()]) return false;
+  int64_t probe_rows = mind->NumOfTuples(probe_dims, false);
+  return probe_rows <= int64_t(stonedb_sysvar_index_join_max_rows) &&
+         probe_rows * lookup_cost < int64_t(mind->DimSize(key_vc->GetDim()));
+}
+
 void ParameterizedFilter::DisplayJoinResults(DimensionVector &all_involved_dims, JoinAlgType join_performed,
                                              bool is_outer, int conditions_used) {
   if (rccontrol.isOn()) {
@@ -632,7 +731,9 @@ void ParameterizedFilter::DisplayJoinResults(DimensionVector &all_involved_dims,
                        ? " [map]:  "
                        : (join_performed == JoinAlgType::JTYPE_HASH
                               ? " [hash]: "
-                              : (join_performed == JoinAlgType::JTYPE_GENERAL ? " [loop]: " : " [????]: "))))
+                              : (join_performed == JoinAlgType::JTYPE_INDEX
+                                     ? " [index]: "
+                                     : (join_performed == JoinAlgType::JTYPE_GENERAL ? " [loop]: " : " [????]: ")))))
         << tuples_after_join << " \t" << mind->Display() << system::unlock;
   }
 }
@@ -1030,16 +1131,22 @@ void ParameterizedFilter::UpdateMultiIndex(bool count_only, int64_t limit) {
   int last_desc_dim = -1;
   int cur_dim = -1;
 
+  auto one_dim_filter = [this](uint i) {
+    return !descriptors[i].done && descriptors[i].IsInner() && !descriptors[i].IsType_Join() &&
+           !descriptors[i].IsDelayed();
+  };
   int no_desc = 0;
   for (uint i = 0; i < descriptors.Size(); i++)
-    if (!descriptors[i].done && descriptors[i].IsInner() && !descriptors[i].IsType_Join() &&
-        !descriptors[i].IsDelayed())
-      ++no_desc;
+    if (one_dim_filter(i)) ++no_desc;
+
+  // limit should be applied only for the last descriptor
+  auto desc_limit = [&](int desc_no) {
+    return (desc_no != no_desc || no_of_delayed_conditions > 0 || no_of_join_conditions) ? -1 : limit;
+  };
 
   int desc_no = 0;
   for (uint i = 0; i < descriptors.Size(); i++) {
-    if (!descriptors[i].done && descriptors[i].IsInner() && !descriptors[i].IsType_Join() &&
-        !descriptors[i].IsDelayed()) {
+    if (one_dim_filter(i)) {
       ++desc_no;
       if (descriptors[i].attr.vc) {
         cur_dim = descriptors[i].attr.vc->GetDim();
@@ -1049,8 +1156,24 @@ void ParameterizedFilter::UpdateMultiIndex(bool count_only, int64_t limit) {
         RoughMakeProjections(cur_dim, false);
       }
 
-      // limit should be applied only for the last descriptor
-      ApplyDescriptor(i, (desc_no != no_desc || no_of_delayed_conditions > 0 || no_of_join_conditions) ? -1 : limit);
+      // consecutive filters on the same dimension are evaluated together,
+      // each packrow by all of them while it is in the cache
+      std::vector<int> fused;
+      int fused_dim = (desc_limit(desc_no) == -1 ? FusableDescriptorDim(i) : -1);
+      if (fused_dim != -1) {
+        fused.push_back(i);
+        for (uint j = i + 1; j < descriptors.Size(); j++) {
+          if (!one_dim_filter(j)) continue;
+          if (desc_limit(desc_no + fused.size()) != -1 || FusableDescriptorDim(j) != fused_dim) break;
+          fused.push_back(j);
+        }
+      }
+      if (fused.size() > 1) {
+        ApplyDescriptors(fused, fused_dim);
+        desc_no += fused.size() - 1;
+        i = fused.back();
+      } else
+        ApplyDescriptor(i, desc_limit(desc_no));
       if (!descriptors[i].attr.vc) continue;  // probably desc got simplified and is true or false
       if (cur_dim >= 0 && mind->GetFilter(cur_dim) && mind->GetFilter(cur_dim)->IsEmpty() && empty_cannot_grow) {
         mind->Empty();
@@ -1350,6 +1473,119 @@ void ParameterizedFilter::ApplyDescriptor(int desc_number, int64_t limit)
   return;
 }
 
+// the only dimension of a descriptor which may be evaluated pack by pack together
+// with others, -1 if it must be applied on its own
+int ParameterizedFilter::FusableDescriptorDim(int desc_number) {
+  Descriptor &desc = descriptors[desc_number];
+  if (desc.op == common::Operator::O_TRUE || desc.op == common::Operator::O_FALSE || !desc.attr.vc) return -1;
+  if (desc.IsType_Subquery() || desc.ExsitTmpTable() || desc.IsleftIndexSearch() || !desc.IsDeterministic())
+    return -1;
+  DimensionVector dims(mind->NumOfDimensions());
+  desc.DimensionUsed(dims);
+  if (dims.NoDimsUsed() != 1) return -1;
+  for (int i = 0; i < mind->NumOfDimensions(); i++)
+    if (dims[i]) return (mind->GetFilter(i) ? i : -1);
+  return -1;
+}
+
+void ParameterizedFilter::ApplyDescriptors(const std::vector<int> &desc_numbers, int one_dim) {
+  DimensionVector dims(mind->NumOfDimensions());
+  dims[one_dim] = true;
+  mind->MarkInvolvedDimGroups(dims);
+
+  std::vector<common::RSValue *> rfs;
+  for (auto d : desc_numbers) rfs.push_back(rough_mind->GetLocalDescFilter(one_dim, d, true));
+
+  int packs_no = (int)((mind->OrigSize(one_dim) + ((1 << mind->ValueOfPower()) - 1)) >> mind->ValueOfPower());
+  int pack_some = 0;
+  for (int b = 0; b < rough_mind->NoPacks(one_dim); b++) {
+    if (rough_mind->GetPackStatus(one_dim, b) != common::RSValue::RS_NONE) pack_some++;
+  }
+  MIUpdatingIterator mit(mind, dims);
+  for (auto d : desc_numbers) descriptors[d].CopyDesCond(mit);
+
+  int poolsize = rceng->query_thread_pool.size();
+  if ((stonedb_sysvar_threadpoolsize > 0) && (packs_no / poolsize > 0)) {
+    int task_num = (pack_some <= poolsize ? poolsize : packs_no / (pack_some / poolsize));
+    int mod = packs_no % task_num;
+    int num = packs_no / task_num;
+
+    for (auto d : desc_numbers) descriptors[d].InitParallel(task_num, mit);
+
+    std::vector<MultiIndex> mis;
+    mis.reserve(task_num);
+    std::vector<MIUpdatingIterator> taskIterator;
+    taskIterator.reserve(task_num);
+    for (int i = 0; i < task_num; ++i) {
+      auto &mi = mis.emplace_back(*mind, true);
+      int pstart = ((i == 0) ? 0 : mod + i * num);
+      int pend = mod + (i + 1) * num - 1;
+
+      auto &mii = taskIterator.emplace_back(&mi, dims);
+      mii.SetTaskNum(task_num);
+      mii.SetTaskId(i);
+      mii.SetNoPacksToGo(pend);
+      mii.RewindToPack(pstart);
+    }
+
+    utils::result_set<void> res;
+    for (int i = 0; i < task_num; ++i) {
+      res.insert(rceng->query_thread_pool.add_task(&ParameterizedFilter::TaskProcessPacksFused, this,
+                                                   &taskIterator[i], current_tx, &rfs, &desc_numbers, one_dim));
+    }
+    res.get_all_with_except();
+
+    if (mind->m_conn->Killed()) throw common::KilledException("catch thread pool Exception: TaskProcessPacksFused");
+    mind->UpdateNumOfTuples();
+  } else {
+    while (mit.IsValid()) {
+      EvaluatePackrow(mit, rfs, desc_numbers, one_dim);
+      if (mind->m_conn->Killed()) throw common::KilledException();
+    }
+    mit.Commit();
+  }
+
+  Filter *f = mind->GetFilter(one_dim);
+  for (int p = 0; p < rough_mind->NoPacks(one_dim); p++)
+    if (f->IsEmpty(p)) rough_mind->SetPackStatus(one_dim, p, common::RSValue::RS_NONE);
+  for (auto d : desc_numbers) {
+    descriptors[d].done = true;
+    descriptors[d].UpdateVCStatistics();
+  }
+}
+
+// Evaluate all the descriptors on the current packrow, each one on the rows
+// left by the previous ones, and move to the next packrow.
+void ParameterizedFilter::EvaluatePackrow(MIUpdatingIterator &mit, const std::vector<common::RSValue *> &rfs,
+                                          const std::vector<int> &desc_numbers, int one_dim) {
+  int pack = mit.GetCurPackrow(one_dim);
+  for (auto rf : rfs) {
+    if (rf && pack >= 0 && rf[pack] == common::RSValue::RS_NONE) {
+      mit.ResetCurrentPack();
+      mit.NextPackrow();
+      return;
+    }
+  }
+  bool evaluated = false;
+  for (size_t k = 0; k < desc_numbers.size(); k++) {
+    if (rfs[k] && pack >= 0 && rfs[k][pack] == common::RSValue::RS_ALL) continue;
+    // otherwise the pack is already empty and the iterator is on the next one
+    if (evaluated && (!mit.RewindToPack(pack) || !mit.IsValid())) return;
+    descriptors[desc_numbers[k]].EvaluatePack(mit);
+    evaluated = true;
+  }
+  if (!evaluated) mit.NextPackrow();
+}
+
+void ParameterizedFilter::TaskProcessPacksFused(MIUpdatingIterator *taskIterator, Transaction *ci,
+                                                const std::vector<common::RSValue *> *rfs,
+                                                const std::vector<int> *desc_numbers, int one_dim) {
+  current_tx = ci;
+  common::SetMySQLTHD(ci->Thd());
+  while (taskIterator->IsValid() && !ci->Killed()) EvaluatePackrow(*taskIterator, *rfs, *desc_numbers, one_dim);
+  taskIterator->Commit(false);
+}
+
 void ParameterizedFilter::TaskProcessPacks(MIUpdatingIterator *taskIterator, Transaction *ci, common::RSValue *rf,
                                            [[maybe_unused]] DimensionVector *dims, int desc_number, int64_t limit,
                                            int one_dim) {
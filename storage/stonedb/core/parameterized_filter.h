@@ -49,6 +49,7 @@ class ParameterizedFilter final {
   void RoughUpdateParamFilter();
   void UpdateMultiIndex(bool count_only, int64_t limit);
   bool RoughUpdateMultiIndex();
+  bool RoughUpdateMultiColumnIndexes();
   void RoughUpdateJoins();
   bool PropagateRoughToMind();
   void SyntacticalDescriptorListPreprocessing(bool for_rough_query = false);
@@ -57,9 +58,13 @@ class ParameterizedFilter final {
   void RoughMakeProjections();
   void RoughMakeProjections(int dim, bool update_reduced = true);
   void UpdateJoinCondition(Condition &cond, JoinTips &tips);
+  bool IndexJoinPreferred(Condition &cond);
   void DisplayJoinResults(DimensionVector &all_involved_dims, JoinAlgType cur_join_type, bool is_outer,
                           int conditions_used);
   void ApplyDescriptor(int desc_number, int64_t limit = -1);
+  // one-dimensional descriptors on the same dimension, evaluated pack by pack
+  void ApplyDescriptors(const std::vector<int> &desc_numbers, int one_dim);
+  int FusableDescriptorDim(int desc_number);
   static bool TryToMerge(Descriptor &d1, Descriptor &d2);
   void PrepareJoiningStep(Condition &join_desc, Condition &desc, int desc_no, MultiIndex &mind);
   void RoughSimplifyCondition(Condition &desc);
@@ -75,6 +80,9 @@ class ParameterizedFilter final {
   Condition &GetConditions() { return descriptors; }
   void TaskProcessPacks(MIUpdatingIterator *taskIterator, Transaction *ci, common::RSValue *rf, DimensionVector *dims,
                         int desc_number, int64_t limit, int one_dim);
+  void TaskProcessPacksFused(MIUpdatingIterator *taskIterator, Transaction *ci,
+                             const std::vector<common::RSValue *> *rfs, const std::vector<int> *desc_numbers,
+                             int one_dim);
 
   MultiIndex *mind;
   RoughMultiIndex *rough_mind;
@@ -86,6 +94,8 @@ class ParameterizedFilter final {
   CondType filter_type;
 
   void AssignInternal(const ParameterizedFilter &pf);
+  void EvaluatePackrow(MIUpdatingIterator &mit, const std::vector<common::RSValue *> &rfs,
+                       const std::vector<int> &desc_numbers, int one_dim);
 };
 }  // namespace core
 }  // namespace stonedb
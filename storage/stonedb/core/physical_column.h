@@ -53,6 +53,18 @@ class PhysicalColumn : public Column {
   virtual int64_t GetValueInt64(int64_t row) const = 0;
   virtual int64_t GetNotNullValueInt64(int64_t row) const = 0;
 
+  /*! \brief Get numeric values of many rows at once
+   *
+   * \pre necessary datapacks are loaded and locked
+   *
+   * \param rows_values on entry: row numbers (common::NULL_VALUE_64 for a null
+   * row of an outer join), replaced in place with GetValueInt64() of each row.
+   * Rows of one pack should be adjacent, the pack is looked up once for them.
+   */
+  virtual void GetValuesInt64(int64_t *rows_values, size_t n) const {
+    for (size_t i = 0; i < n; i++) rows_values[i] = GetValueInt64(rows_values[i]);
+  }
+
   /*! \brief Is the column value NULL ?
    *
    * \pre necessary datapacks (containing rows pointed by \e mit) are loaded and
@@ -54,6 +54,11 @@ void Query::UnlockPackInfoFromUse() {
   for (auto &it : t) it->UnlockPackInfoFromUse();
 };
 
+int Query::Fallback(const char *reason) {
+  m_conn->SetFallbackReason(reason);
+  return RETURN_QUERY_TO_MYSQL_ROUTE;
+}
+
 bool Query::IsCountStar(Item *item_sum) {
   Item_sum_count *is = dynamic_cast<Item_sum_count *>(item_sum);
   if (is)
@@ -569,6 +574,10 @@ TempTable *Query::Preexecute(CompiledQuery &qu, ResultSender *sender, [[maybe_un
   auto global_limits = qu.GetGlobalLimit();
 
   cq = &qu;
+  // UNION steps of one chain wait until their output table is needed, so that
+  // all the branches are known and can be materialized concurrently
+  std::vector<int> union_steps;
+
   // Execution itself
   for (int i = 0; i < qu.NumOfSteps(); i++) {
     CompiledQuery::CQStep step = qu.Step(i);
@@ -608,6 +617,16 @@ TempTable *Query::Preexecute(CompiledQuery &qu, ResultSender *sender, [[maybe_un
 
     // Implementation of steps
     try {
+      if (!union_steps.empty()) {
+        const TabID &out = qu.Step(union_steps[0]).t1;
+        bool needed = (step.type == CompiledQuery::StepType::UNION) ? step.t1 != out : StepUsesTable(i, out);
+        for (size_t u = 0; u < union_steps.size() && !needed; u++)
+          needed = StepUsesTable(i, qu.Step(union_steps[u]).t3);
+        if (needed) {
+          ExecuteUnions(union_steps, sender, global_limits);
+          union_steps.clear();
+        }
+      }
       switch (step.type) {
         case CompiledQuery::StepType::TABLE_ALIAS:
           ta[-step.t1.n - 1] = t2_ptr;
@@ -844,6 +863,15 @@ TempTable *Query::Preexecute(CompiledQuery &qu, ResultSender *sender, [[maybe_un
                           (int)step.n1);  // step.n1 = 0 for asc, 1 for desc
           break;
         }
+        case CompiledQuery::StepType::ADD_WINDOW: {
+          DEBUG_ASSERT(step.t1.n < 0 && ta[-step.t1.n - 1]->TableType() == TType::TEMP_TABLE);
+          std::vector<int> partition;
+          for (auto col : step.virt_cols) partition.push_back(-col - 1);
+          ((TempTable *)ta[-step.t1.n - 1].get())
+              ->AddWindow(-step.a1.n - 1, int(step.n1), step.n2,
+                          step.a2.n == common::NULL_VALUE_32 ? -1 : -step.a2.n - 1, partition);
+          break;
+        }
         case CompiledQuery::StepType::UNION:
           DEBUG_ASSERT(step.t1.n < 0 && step.t2.n < 0 && step.t3.n < 0);
           DEBUG_ASSERT(ta[-step.t2.n - 1]->TableType() == TType::TEMP_TABLE &&
@@ -856,17 +884,14 @@ TempTable *Query::Preexecute(CompiledQuery &qu, ResultSender *sender, [[maybe_un
             else
               ((TempTable *)ta[-step.t1.n - 1].get())
                   ->RoughUnion((TempTable *)ta[-step.t3.n - 1].get(), qu.IsResultTable(step.t1) ? sender : NULL);
-          } else if (qu.IsResultTable(step.t1) && !qu.IsOrderedBy(step.t1) && step.n1)
-            ((TempTable *)ta[-step.t1.n - 1].get())
-                ->Union((TempTable *)ta[-step.t3.n - 1].get(), (int)step.n1, sender, global_limits.first,
-                        global_limits.second);
+          } else if (step.t3.n != common::NULL_VALUE_32 && rceng->union_thread_pool.size() > 0)
+            union_steps.push_back(i);
           else {
-            if (step.t3.n == common::NULL_VALUE_32)
-              ((TempTable *)ta[-step.t1.n - 1].get())->Union(NULL, (int)step.n1);
-            else {
-              ((TempTable *)ta[-step.t1.n - 1].get())->Union((TempTable *)ta[-step.t3.n - 1].get(), (int)step.n1);
-              ta[-step.t3.n - 1].reset();
+            if (!union_steps.empty()) {
+              ExecuteUnions(union_steps, sender, global_limits);
+              union_steps.clear();
             }
+            ExecuteUnion(i, sender, global_limits);
           }
           break;
         case CompiledQuery::StepType::RESULT:
@@ -887,6 +912,13 @@ TempTable *Query::Preexecute(CompiledQuery &qu, ResultSender *sender, [[maybe_un
     }
   }
 
+  try {
+    if (!union_steps.empty()) ExecuteUnions(union_steps, sender, global_limits);
+  } catch (...) {
+    for (auto &c : conds) delete c;
+    throw;
+  }
+
   for (auto &c : conds) delete c;
 
   // NOTE: output_table is sent out of this function and should be managed
@@ -896,6 +928,70 @@ TempTable *Query::Preexecute(CompiledQuery &qu, ResultSender *sender, [[maybe_un
   return output_table;
 }
 
+bool Query::StepUsesTable(int step_no, const TabID &tab) {
+  CompiledQuery::CQStep &step = cq->Step(step_no);
+  if (step.t1 == tab || step.t2 == tab || step.t3 == tab) return true;
+  return std::find(step.tables1.begin(), step.tables1.end(), tab) != step.tables1.end() ||
+         std::find(step.tables2.begin(), step.tables2.end(), tab) != step.tables2.end();
+}
+
+void Query::ExecuteUnions(const std::vector<int> &union_steps, ResultSender *sender,
+                          std::pair<int64_t, int64_t> &global_limits) {
+  // the output table of the chain is its first branch
+  std::vector<TempTable *> branches{(TempTable *)ta[-cq->Step(union_steps[0]).t1.n - 1].get()};
+  bool concurrent = true;
+  for (int s : union_steps) {
+    CompiledQuery::CQStep &step = cq->Step(s);
+    branches.push_back((TempTable *)ta[-step.t3.n - 1].get());
+    // limits of a sent result are passed on from branch to branch
+    if (cq->IsResultTable(step.t1) && !cq->IsOrderedBy(step.t1) && step.n1 &&
+        (global_limits.first != 0 || global_limits.second != -1))
+      concurrent = false;
+  }
+  for (auto t : branches)
+    if (t->IsParametrized()) concurrent = false;
+  if (!concurrent) {
+    for (int s : union_steps) ExecuteUnion(s, sender, global_limits);
+    return;
+  }
+
+  rccontrol.lock(m_conn->GetThreadID()) << "UNION: materializing " << branches.size() << " components concurrently."
+                                        << system::unlock;
+  utils::result_set<void> res;
+  for (auto t : branches)
+    res.insert(rceng->union_thread_pool.add_task(&Query::MaterializeUnionBranch, this, t, current_tx));
+  try {
+    res.get(0);
+    for (size_t i = 0; i < union_steps.size(); i++) {
+      res.get(i + 1);
+      ExecuteUnion(union_steps[i], sender, global_limits);
+    }
+  } catch (...) {
+    res.wait_all();
+    throw;
+  }
+}
+
+void Query::ExecuteUnion(int step_no, ResultSender *sender, std::pair<int64_t, int64_t> &global_limits) {
+  CompiledQuery::CQStep &step = cq->Step(step_no);
+  TempTable *t = (TempTable *)ta[-step.t1.n - 1].get();
+  if (cq->IsResultTable(step.t1) && !cq->IsOrderedBy(step.t1) && step.n1)
+    t->Union((TempTable *)ta[-step.t3.n - 1].get(), (int)step.n1, sender, global_limits.first, global_limits.second);
+  else if (step.t3.n == common::NULL_VALUE_32)
+    t->Union(NULL, (int)step.n1);
+  else {
+    t->Union((TempTable *)ta[-step.t3.n - 1].get(), (int)step.n1);
+    ta[-step.t3.n - 1].reset();
+  }
+}
+
+void Query::MaterializeUnionBranch(TempTable *t, Transaction *tx) {
+  // save TLS for mysql function
+  common::SetMySQLTHD(m_conn->Thd());
+  current_tx = tx;
+  t->Materialize();
+}
+
 int Query::Item2CQTerm(Item *an_arg, CQTerm &term, const TabID &tmp_table, CondType filter_type, bool negative,
                        Item *left_expr_for_subselect, common::Operator *oper_for_subselect) {
   an_arg = UnRef(an_arg);
@@ -1012,16 +1108,15 @@ int Query::Item2CQTerm(Item *an_arg, CQTerm &term, const TabID &tmp_table, CondT
             tab_id2expression.insert(std::make_pair(tmp_table, std::make_pair(vc.n, mysql_expression)));
           }
         } else
-          return RETURN_QUERY_TO_MYSQL_ROUTE;  // too large binary to be treated
-                                               // as BIGINT
+          return Fallback("binary constant too large for BIGINT");
       } else {
-        return RETURN_QUERY_TO_MYSQL_ROUTE;
+        return Fallback("NULL binary constant");
       }
     } else {
       MysqlExpression *expr;
       MysqlExpression::SetOfVars vars;
       if (WrapMysqlExpression(an_arg, tmp_table, expr, false, true) == WrapStatus::FAILURE)
-        return RETURN_QUERY_TO_MYSQL_ROUTE;
+        return Fallback("unsupported expression in HAVING");
       if (IsConstExpr(expr->GetVars(), tmp_table)) {
         vc.n = VirtualColumnAlreadyExists(tmp_table, expr);
         if (vc.n == common::NULL_VALUE_32) {
@@ -1083,15 +1178,14 @@ int Query::Item2CQTerm(Item *an_arg, CQTerm &term, const TabID &tmp_table, CondT
             tab_id2expression.insert(std::make_pair(tmp_table, std::make_pair(vc.n, mysql_expression)));
           }
         } else
-          return RETURN_QUERY_TO_MYSQL_ROUTE;  // too large binary to be treated
-                                               // as BIGINT
+          return Fallback("binary constant too large for BIGINT");
       } else {
-        return RETURN_QUERY_TO_MYSQL_ROUTE;
+        return Fallback("NULL binary constant");
       }
     } else {
       MysqlExpression *expr;
       WrapStatus ws = WrapMysqlExpression(an_arg, tmp_table, expr, true, false);
-      if (ws != WrapStatus::SUCCESS) return RETURN_QUERY_TO_MYSQL_ROUTE;
+      if (ws != WrapStatus::SUCCESS) return Fallback("unsupported expression in a condition");
       vc.n = VirtualColumnAlreadyExists(tmp_table, expr);
       if (vc.n == common::NULL_VALUE_32) {
         cq->CreateVirtualColumn(vc, tmp_table, expr);
@@ -1563,7 +1657,7 @@ int Query::BuildConditions(Item *conds, CondID &cond_id, CompiledQuery *cq, cons
   this->cq = cq;
 
   CondID res = ConditionNumber(conds, tmp_table, filter_type);
-  if (res.IsInvalid()) return RETURN_QUERY_TO_MYSQL_ROUTE;
+  if (res.IsInvalid()) return Fallback("unsupported condition");
 
   if (filter_type == CondType::HAVING_COND) {
     cq->CreateConds(res, tmp_table, res, false);
@@ -1763,7 +1857,7 @@ int Query::PrefixCheck(Item *conds) {
           break;
         }
         default:
-          return RETURN_QUERY_TO_MYSQL_ROUTE;  // unknown function type
+          return Fallback("unknown function type in a condition");
       }
       break;
     }
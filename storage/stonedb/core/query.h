@@ -91,6 +91,10 @@ class Query final {
 
   bool rough_query = false;  // set as true to enable rough execution
 
+  // records why the query can not be executed by StoneDB, returns
+  // RETURN_QUERY_TO_MYSQL_ROUTE
+  int Fallback(const char *reason);
+
   bool FieldUnmysterify(Item *item, TabID &tab, AttrID &col);
   int FieldUnmysterify(Item *item, const char *&database_name, const char *&table_name, const char *&table_alias,
                        const char *&table_path, const TABLE *&table_ptr, const char *&field_name,
@@ -170,6 +174,23 @@ class Query final {
                          bool is_or_subtree = false);
   int BuildCondsIfPossible(Item *conds, CondID &cond_id, const TabID &tmp_table, JoinType join_type);
 
+  /*! \brief Checks if a step of the compiled query refers to a table
+   * \param step_no - number of the step
+   * \param tab - table id
+   * \return true if yes
+   */
+  bool StepUsesTable(int step_no, const TabID &tab);
+
+  /*! \brief Executes a chain of UNION steps with the same output table. The
+   * branches are materialized concurrently on the union thread pool and merged
+   * (or sent) in the order of the steps, each as soon as it is ready.
+   * \param union_steps - numbers of the UNION steps
+   */
+  void ExecuteUnions(const std::vector<int> &union_steps, ResultSender *sender,
+                     std::pair<int64_t, int64_t> &global_limits);
+  void ExecuteUnion(int step_no, ResultSender *sender, std::pair<int64_t, int64_t> &global_limits);
+  void MaterializeUnionBranch(TempTable *t, Transaction *tx);
+
  public:
   /*! \brief Removes ALL/ANY modifier from an operator
    * \param op - operator
@@ -253,6 +274,13 @@ class Query final {
   int AddColumnForMysqlExpression(MysqlExpression *mysql_expression, const TabID &tmp_table, const char *alias,
                                   const common::ColOperation oper, const bool distinct, bool group_by = false);
 
+  /*! \brief Creates AddColumn steps for the arguments and the result of an
+   * analytic function and the AddWindow step computing it \param item - the
+   * function \param tmp_table - for which TempTable \return
+   * RCBASE_QUERY_ROUTE on success, RETURN_QUERY_TO_MYSQL_ROUTE otherwise
+   */
+  int AddWindowColumn(Item_func_sdb_window *item, const TabID &tmp_table);
+
   /*! \brief Computes identifier of a column created by AddColumn operation
    * \param vc - for which virtual column
    * \param tmp_table -  for which TempTable
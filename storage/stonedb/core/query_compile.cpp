@@ -70,6 +70,7 @@ int JudgeErrors(SELECT_LEX *sl) {
   if (sl->olap == ROLLUP_TYPE) {
     /*my_message(ER_SYNTAX_ERROR, "StoneDB specific error: WITH ROLLUP not
      supported", MYF(0)); throw ReturnMeToMySQLWithError();*/
+    current_tx->SetFallbackReason("WITH ROLLUP");
     return RETURN_QUERY_TO_MYSQL_ROUTE;
   }
 
@@ -299,8 +300,7 @@ int Query::AddJoins(List<TABLE_LIST> &join, TabID &tmp_table, std::vector<TabID>
   std::vector<TABLE_LIST *> reversed;
 
   if (!join.elements)
-    return RETURN_QUERY_TO_MYSQL_ROUTE;  // no tables in table list in this
-                                         // select
+    return Fallback("SELECT without tables in a UNION");  // no tables in table list in this select
   // if the table list was empty altogether, we wouldn't even enter
   // Compilation(...) it must be sth. like `select 1 from t1 union select 2` and
   // we are in the second select in the union
@@ -317,7 +317,7 @@ int Query::AddJoins(List<TABLE_LIST> &join, TabID &tmp_table, std::vector<TabID>
       JoinType join_type = GetJoinTypeAndCheckExpr(join_ptr->outer_join, join_ptr->join_cond());
       CondID cond_id;
       if (!BuildCondsIfPossible(join_ptr->join_cond(), cond_id, tmp_table, join_type))
-        return RETURN_QUERY_TO_MYSQL_ROUTE;
+        return Fallback("unsupported join condition");
       left_tables.insert(left_tables.end(), right_tables.begin(), right_tables.end());
       local_left.insert(local_left.end(), local_right.begin(), local_right.end());
       if (join_ptr->outer_join)
@@ -343,7 +343,7 @@ int Query::AddJoins(List<TABLE_LIST> &join, TabID &tmp_table, std::vector<TabID>
         table_alias = join_ptr->alias;
       } else {
         if (!TableUnmysterify(join_ptr, database_name, table_name, table_alias, table_path))
-          return RETURN_QUERY_TO_MYSQL_ROUTE;
+          return Fallback("unsupported table reference");
         int tab_num = path2num[table_path];  // number of a table on a list in
                                              // `this` QUERY object
         int id = t[tab_num]->GetID();
@@ -366,7 +366,7 @@ int Query::AddJoins(List<TABLE_LIST> &join, TabID &tmp_table, std::vector<TabID>
         //	return RETURN_QUERY_TO_MYSQL_ROUTE;
         CondID cond_id;
         if (!BuildCondsIfPossible(join_ptr->join_cond(), cond_id, tmp_table, join_type))
-          return RETURN_QUERY_TO_MYSQL_ROUTE;
+          return Fallback("unsupported join condition");
         if (join_ptr->join_cond() && join_ptr->outer_join) {
           right_tables.push_back(tab);
           cq->LeftJoinOn(tmp_table, left_tables, right_tables, cond_id);
@@ -392,12 +392,13 @@ int Query::AddFields(List<Item> &fields, TabID const &tmp_table, bool const grou
   List_iterator_fast<Item> li(fields);
   Item *item;
   int added = 0;
+  bool window_used = false;
   item = li++;
   while (item) {
     WrapStatus ws;
     common::ColOperation oper;
     bool distinct;
-    if (!OperationUnmysterify(item, oper, distinct, group_by_clause)) return RETURN_QUERY_TO_MYSQL_ROUTE;
+    if (!OperationUnmysterify(item, oper, distinct, group_by_clause)) return Fallback("unsupported aggregate function");
 
     if (IsAggregationItem(item)) aggregation_used = true;
 
@@ -406,8 +407,14 @@ int Query::AddFields(List<Item> &fields, TabID const &tmp_table, bool const grou
     if (ignore_minmax && (oper == common::ColOperation::MIN || oper == common::ColOperation::MAX))
       oper = common::ColOperation::LISTING;
 
+    // select ANALYTIC FUNCTION, computed on the materialized rows
+    if (dynamic_cast<Item_func_sdb_window *>(item)) {
+      if (group_by_clause) return Fallback("analytic function with GROUP BY");
+      if (!AddWindowColumn(static_cast<Item_func_sdb_window *>(item), tmp_table)) return RETURN_QUERY_TO_MYSQL_ROUTE;
+      window_used = true;
+    }
     // select PHYSICAL COLUMN or AGGREGATION over PHYSICAL COLUMN
-    if ((IsFieldItem(item) || IsAggregationOverFieldItem(item)) && IsLocalColumn(item, tmp_table))
+    else if ((IsFieldItem(item) || IsAggregationOverFieldItem(item)) && IsLocalColumn(item, tmp_table))
       AddColumnForPhysColumn(item, tmp_table, oper, distinct, false, item->item_name.ptr());
     // REF to FIELD_ITEM
     else if (item->type() == Item::REF_ITEM) {
@@ -435,7 +442,8 @@ int Query::AddFields(List<Item> &fields, TabID const &tmp_table, bool const grou
     else if (IsAggregationItem(item)) {
       // select AGGREGATION over EXPRESSION
       Item_sum *item_sum = (Item_sum *)item;
-      if (item_sum->get_arg_count() > 1 || HasAggregation(item_sum->get_arg(0))) return RETURN_QUERY_TO_MYSQL_ROUTE;
+      if (item_sum->get_arg_count() > 1 || HasAggregation(item_sum->get_arg(0)))
+        return Fallback("aggregate of several arguments or nested aggregates");
       if (IsCountStar(item_sum)) {  // count(*) doesn't need any virtual column
         AttrID at;
         cq->AddColumn(at, tmp_table, CQTerm(), oper, item_sum->item_name.ptr(), false);
@@ -443,7 +451,7 @@ int Query::AddFields(List<Item> &fields, TabID const &tmp_table, bool const grou
       } else {
         MysqlExpression *expr;
         ws = WrapMysqlExpression(item_sum->get_arg(0), tmp_table, expr, false, false);
-        if (ws == WrapStatus::FAILURE) return RETURN_QUERY_TO_MYSQL_ROUTE;
+        if (ws == WrapStatus::FAILURE) return Fallback("unsupported expression in an aggregate");
         AddColumnForMysqlExpression(expr, tmp_table,
                                     ignore_minmax ? item_sum->get_arg(0)->item_name.ptr() : item_sum->item_name.ptr(),
                                     oper, distinct);
@@ -464,7 +472,7 @@ int Query::AddFields(List<Item> &fields, TabID const &tmp_table, bool const grou
       }
       MysqlExpression *expr(NULL);
       ws = WrapMysqlExpression(item, tmp_table, expr, false, oper == common::ColOperation::DELAYED);
-      if (ws == WrapStatus::FAILURE) return RETURN_QUERY_TO_MYSQL_ROUTE;
+      if (ws == WrapStatus::FAILURE) return Fallback("unsupported expression in the select list");
       if (!item->item_name.ptr()) {
         Item_func_conv_charset *item_conv = dynamic_cast<Item_func_conv_charset *>(item);
         if (item_conv) {
@@ -479,10 +487,41 @@ int Query::AddFields(List<Item> &fields, TabID const &tmp_table, bool const grou
     added++;
     item = li++;
   }
+  if (window_used && aggregation_used) return Fallback("analytic function with aggregation");
   num_of_added_fields = added;
   return RCBASE_QUERY_ROUTE;
 }
 
+int Query::AddWindowColumn(Item_func_sdb_window *item, const TabID &tmp_table) {
+  // the value argument and the partition columns, as hidden columns
+  std::vector<int> cols;
+  for (uint i = 0; i < item->argument_count(); i++) {
+    if (i == 1 && item->leading_arg_count() == 2) continue;  // LAG/LEAD distance
+    Item *arg = UnRef(item->arguments()[i]);
+    if (IsFieldItem(arg) && IsLocalColumn(arg, tmp_table)) {
+      cols.push_back(AddColumnForPhysColumn(arg, tmp_table, common::ColOperation::LISTING, false, true));
+    } else {
+      MysqlExpression *expr = NULL;
+      if (WrapMysqlExpression(arg, tmp_table, expr, false, false) == WrapStatus::FAILURE)
+        return Fallback("unsupported argument of an analytic function");
+      cols.push_back(AddColumnForMysqlExpression(expr, tmp_table, NULL, common::ColOperation::LISTING, false, true));
+    }
+    if (cols.back() == common::NULL_VALUE_32) return Fallback("unsupported argument of an analytic function");
+  }
+
+  // the result: a placeholder column filled in after materialization
+  MysqlExpression *expr = NULL;
+  if (WrapMysqlExpression(new Item_int(static_cast<longlong>(0)), tmp_table, expr, false, false) == WrapStatus::FAILURE)
+    return Fallback("unsupported analytic function");
+  int col = AddColumnForMysqlExpression(expr, tmp_table, item->item_name.ptr(), common::ColOperation::LISTING, false);
+
+  bool has_arg = item->leading_arg_count() > 0;
+  std::vector<int> partition(cols.begin() + (has_arg ? 1 : 0), cols.end());
+  cq->AddWindow(tmp_table, AttrID(col), int(item->window_kind()), item->row_offset(),
+                AttrID(has_arg ? cols[0] : common::NULL_VALUE_32), partition);
+  return RCBASE_QUERY_ROUTE;
+}
+
 int Query::AddGroupByFields(ORDER *group_by, const TabID &tmp_table) {
   for (; group_by; group_by = group_by->next) {
     if (group_by->direction != ORDER::ORDER_ASC) {
@@ -512,7 +551,7 @@ int Query::AddGroupByFields(ORDER *group_by, const TabID &tmp_table) {
     } else {  // group by COMPLEX EXPRESSION
       MysqlExpression *expr = 0;
       if (WrapStatus::FAILURE == WrapMysqlExpression(item, tmp_table, expr, true, true))
-        return RETURN_QUERY_TO_MYSQL_ROUTE;
+        return Fallback("unsupported expression in GROUP BY");
       AddColumnForMysqlExpression(expr, tmp_table, item->item_name.ptr(), common::ColOperation::GROUP_BY, false, true);
     }
   }
@@ -531,7 +570,7 @@ int Query::AddOrderByFields(ORDER *order_by, TabID const &tmp_table, int const g
         item->type() != Item::SUBSELECT_ITEM) {
       MysqlExpression *expr = NULL;
       WrapStatus ws = WrapMysqlExpression(item, tmp_table, expr, false, false);
-      if (ws == WrapStatus::FAILURE) return RETURN_QUERY_TO_MYSQL_ROUTE;
+      if (ws == WrapStatus::FAILURE) return Fallback("unsupported expression in ORDER BY");
       DEBUG_ASSERT(!expr->IsDeterministic());
       int col_num = AddColumnForMysqlExpression(expr, tmp_table, NULL, common::ColOperation::LISTING, false, true);
       vc = VirtualColumnAlreadyExists(tmp_table, tmp_table, AttrID(-col_num - 1));
@@ -552,7 +591,7 @@ int Query::AddOrderByFields(ORDER *order_by, TabID const &tmp_table, int const g
         }
 
         WrapStatus ws = WrapMysqlExpression(item, tmp_table, expr, false, delayed);
-        if (ws == WrapStatus::FAILURE) return RETURN_QUERY_TO_MYSQL_ROUTE;
+        if (ws == WrapStatus::FAILURE) return Fallback("unsupported expression in ORDER BY");
         DEBUG_ASSERT(expr->IsDeterministic());
         int col_num = AddColumnForMysqlExpression(
             expr, tmp_table, NULL, delayed ? common::ColOperation::DELAYED : common::ColOperation::LISTING, false,
@@ -603,17 +642,17 @@ int Query::AddGlobalOrderByFields(SQL_I_List<ORDER> *global_order, const TabID &
     // the way to traverse 'global_order' list maybe is not very orthodox, but
     // it works
 
-    if (order_by == nullptr) return RETURN_QUERY_TO_MYSQL_ROUTE;
+    if (order_by == nullptr) return Fallback("unsupported ORDER BY of a UNION");
 
     int col_num = common::NULL_VALUE_32;
     if ((*(order_by->item))->type() == Item::INT_ITEM) {
       col_num = int((*(order_by->item))->val_int());
-      if (col_num < 1 || col_num > max_col) return RETURN_QUERY_TO_MYSQL_ROUTE;
+      if (col_num < 1 || col_num > max_col) return Fallback("unsupported ORDER BY of a UNION");
       col_num--;
       col_num = -col_num - 1;  // make it negative as are columns in TempTable
     } else {
       Item *item = *(order_by->item);
-      if (!item->item_name.ptr()) return RETURN_QUERY_TO_MYSQL_ROUTE;
+      if (!item->item_name.ptr()) return Fallback("unsupported ORDER BY of a UNION");
       bool found = false;
       for (auto &it : field_alias2num) {
         if (tmp_table.n == it.first.first && strcasecmp(it.first.second.c_str(), item->item_name.ptr()) == 0) {
@@ -622,7 +661,7 @@ int Query::AddGlobalOrderByFields(SQL_I_List<ORDER> *global_order, const TabID &
           break;
         }
       }
-      if (!found) return RETURN_QUERY_TO_MYSQL_ROUTE;
+      if (!found) return Fallback("unsupported ORDER BY of a UNION");
     }
     int attr;
     cq->CreateVirtualColumn(attr, tmp_table, tmp_table, AttrID(col_num));
@@ -974,16 +1013,23 @@ int Query::Compile(CompiledQuery *compiled_query, SELECT_LEX *selects_list, SELE
 
       if (left_expr_for_subselect)
         if (!ClearSubselectTransformation(*oper_for_subselect, field_for_subselect, conds, having, cond_to_reinsert,
-                                          list_to_reinsert, left_expr_for_subselect))
+                                          list_to_reinsert, left_expr_for_subselect)) {
+          Fallback("unsupported subquery transformation");
           throw CompilationError();
+        }
 
-      if (having && !group)  // we cannot handle the case of a having without a group by
+      if (having && !group) {  // we cannot handle the case of a having without a group by
+        Fallback("HAVING without GROUP BY");
         throw CompilationError();
+      }
 
       TABLE_LIST *tables = sl->leaf_tables ? sl->leaf_tables : (TABLE_LIST *)sl->table_list.first;
       for (TABLE_LIST *table_ptr = tables; table_ptr; table_ptr = table_ptr->next_leaf) {
         if (!table_ptr->is_view_or_derived()) {
-          if (!Engine::IsSDBTable(table_ptr->table)) throw CompilationError();
+          if (!Engine::IsSDBTable(table_ptr->table)) {
+            Fallback("table of another storage engine");
+            throw CompilationError();
+          }
           std::string path = TablePath(table_ptr);
           if (path2num.find(path) == path2num.end()) {
             path2num[path] = NumOfTabs();
@@ -1026,7 +1072,7 @@ int Query::Compile(CompiledQuery *compiled_query, SELECT_LEX *selects_list, SELE
       cq = saved_cq;
       if (cond_to_reinsert && list_to_reinsert) list_to_reinsert->push_back(cond_to_reinsert);
 	  sl->cleanup(0);
-      return RETURN_QUERY_TO_MYSQL_ROUTE;
+      return Fallback("unsupported SELECT clause");
     }
 
     if (sl->join->select_distinct) cq->Mode(tmp_table, TMParameter::TM_DISTINCT);
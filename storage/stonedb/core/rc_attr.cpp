@@ -16,6 +16,8 @@
 */
 
 #include <cinttypes>
+#include <condition_variable>
+#include <mutex>
 #include <numeric>
 #include <optional>
 
@@ -311,15 +313,44 @@ bool RCAttr::SaveVersion() {
   return true;
 }
 
+bool RCAttr::BeginFilterRebuild(common::PACK_INDEX no_pack) {
+  ASSERT(m_tx != nullptr, "Attempt to modify table in read-only transaction");
+
+  // the filter objects of the write version are shared by all the workers
+  bool has_filter = (GetFilter_Hist() != nullptr);
+  has_filter = (GetFilter_CMap() != nullptr) || has_filter;
+  has_filter = (GetFilter_Bloom() != nullptr) || has_filter;
+  if (!has_filter) return false;
+
+  no_change = false;
+  // the last pack first, so the filter buffers are big enough for all others
+  if (no_pack > 0) RebuildFilters(no_pack - 1, no_pack);
+  return true;
+}
+
+void RCAttr::RebuildFilters(common::PACK_INDEX from, common::PACK_INDEX to) {
+  for (auto pi = from; pi < to; pi++) {
+    if (m_tx->Killed()) throw common::KilledException();
+    auto &dpn = get_dpn(pi);
+    if (dpn.IsLocal()) continue;  // refreshed by SaveVersion()
+    if (dpn.Trivial() && GetPackType() == common::PackType::STR) continue;  // no pack data to scan
+
+    LockPackForUse(pi);
+    std::shared_ptr<void> defer(nullptr, [this, pi](...) { UnlockPackFromUse(pi); });
+    RefreshFilter(pi);
+  }
+}
+
 void RCAttr::PostCommit() {
   if (!no_change) {
     for (size_t i = 0; i < m_idx.size(); i++) {
       auto &dpn = get_dpn(i);
       if (dpn.IsLocal()) {
         dpn.SetLocal(false);
-        if (dpn.base != common::INVALID_PACK_INDEX) m_share->get_dpn_ptr(dpn.base)->xmax = rceng->MaxXID();
+        if (dpn.base != common::INVALID_PACK_INDEX) m_share->retire_dpn(dpn.base, rceng->MaxXID());
       }
     }
+    m_share->reclaim_dpns();
 
     rceng->DeferRemove(Path() / common::COL_VERSION_DIR / m_version.ToString(), m_tid);
     if (m_share->has_filter_bloom)
@@ -340,6 +371,7 @@ void RCAttr::Rollback() {
     if (dpn.IsLocal()) {
       rceng->cache.DropObject(get_pc(i));
       dpn.reset();
+      m_share->free_dpn(m_idx[i]);
     }
   }
   m_tx = nullptr;
@@ -364,6 +396,37 @@ PackOntologicalStatus RCAttr::GetPackOntologicalStatus(int pack_no) {
   return PackOntologicalStatus::NORMAL;
 }
 
+void RCAttr::GetValuesInt64(int64_t *rows_values, size_t n) const {
+  bool real = ATI::IsRealType(TypeName());
+  size_t i = 0;
+  while (i < n) {
+    if (rows_values[i] == common::NULL_VALUE_64) {
+      i++;
+      continue;
+    }
+    // the run of rows from the same pack
+    auto pack = row2pack(rows_values[i]);
+    size_t end = i + 1;
+    while (end < n && rows_values[end] != common::NULL_VALUE_64 && row2pack(rows_values[end]) == pack) end++;
+
+    const auto &dpn = get_dpn(pack);
+    if (dpn.Trivial()) {
+      // nulls only or uniform
+      int64_t v = (dpn.NullOnly() ? common::NULL_VALUE_64 : dpn.min_i);
+      for (; i < end; i++) rows_values[i] = v;
+      continue;
+    }
+    DEBUG_ASSERT(pack_type == common::PackType::INT);
+    auto p = get_packN(pack);
+    DEBUG_ASSERT(p->IsLocked());
+    int64_t base = (real ? 0 : dpn.min_i);  // real values are not min-based
+    for (; i < end; i++) {
+      int inpack = row2offset(rows_values[i]);
+      rows_values[i] = (p->IsNull(inpack) ? common::NULL_VALUE_64 : p->GetValInt(inpack) + base);
+    }
+  }
+}
+
 types::BString RCAttr::GetValueString(const int64_t obj) {
   if (obj == common::NULL_VALUE_64) return types::BString();
   int pack = row2pack(obj);
@@ -718,6 +781,35 @@ size_t RCAttr::GetPrefixLength(int pack) {
   return dif_pos;
 }
 
+namespace {
+// Threads waiting for a pack which is being loaded by another thread. They are
+// striped by the DPN address and the loader wakes up its stripe when done.
+struct alignas(64) PackLoadWaiters {
+  std::mutex mtx;
+  std::condition_variable cv;
+};
+constexpr size_t PACK_LOAD_STRIPES = 64;
+PackLoadWaiters pack_load_waiters[PACK_LOAD_STRIPES];
+
+PackLoadWaiters &WaitersOf(const DPN *dpn) {
+  return pack_load_waiters[(reinterpret_cast<uintptr_t>(dpn) / sizeof(DPN)) % PACK_LOAD_STRIPES];
+}
+
+// publish the result of a load ('v' is the pinned pack or 0 on failure)
+void EndPackLoad(DPN *dpn, uint64_t v) {
+  auto &w = WaitersOf(dpn);
+  uint64_t expected = loading_flag;
+  while (!dpn->CAS(expected, v) && expected == loading_flag) {
+  }
+  {
+    // taking the mutex orders the wake-up after the check of a waiter
+    std::scoped_lock guard(w.mtx);
+  }
+  w.cv.notify_all();
+  ASSERT(expected == loading_flag, "bad loading flag " + std::to_string(expected));
+}
+}  // namespace
+
 void RCAttr::LockPackForUse(common::PACK_INDEX pn) {
   auto dpn = &get_dpn(pn);
   if (dpn->IsLocal()) dpn = m_share->get_dpn_ptr(dpn->base);
@@ -725,6 +817,7 @@ void RCAttr::LockPackForUse(common::PACK_INDEX pn) {
   if (dpn->Trivial() && !dpn->IsLocal()) return;
 
   while (true) {
+    // a resident pack is pinned by incrementing its counter only
     if (dpn->IncRef()) return;
 
     // either the pack is not loaded yet or other thread is loading it
@@ -736,23 +829,24 @@ void RCAttr::LockPackForUse(common::PACK_INDEX pn) {
       try {
         sp = rceng->cache.GetOrFetchObject<Pack>(get_pc(pn), this);
       } catch (std::exception &e) {
-        dpn->SetPackPtr(0);
+        EndPackLoad(dpn, 0);
         STONEDB_LOG(LogCtl_Level::ERROR, "An exception is caught: %s", e.what());
         throw e;
       } catch (...) {
-        dpn->SetPackPtr(0);
+        EndPackLoad(dpn, 0);
         STONEDB_LOG(LogCtl_Level::ERROR, "An unknown system exception error caught.");
         throw;
       }
 
-      uint64_t newv = reinterpret_cast<unsigned long>(sp.get()) + tag_one;
-      uint64_t expected = loading_flag;
-      ASSERT(dpn->CAS(expected, newv),
-             "bad loading flag" + std::to_string(newv) + ". " + Path().string() + " index:" + std::to_string(pn));
+      EndPackLoad(dpn, reinterpret_cast<unsigned long>(sp.get()) + tag_one);
       return;
     }
-    // some one is loading data, wait a while and retry
-    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    if (v != loading_flag) continue;  // pinned or unpinned meanwhile, retry
+
+    // some one is loading data, sleep until the loader is done and retry
+    auto &w = WaitersOf(dpn);
+    std::unique_lock<std::mutex> lk(w.mtx);
+    w.cv.wait(lk, [dpn] { return dpn->GetPackPtr() != loading_flag; });
   }
 }
 
@@ -779,6 +873,37 @@ void RCAttr::UnlockPackFromUse(common::PACK_INDEX pn) {
   }
 }
 
+void RCAttr::GetPackProjection(common::PACK_INDEX pn, uint32_t *nulls, uint32_t *lens, const types::BString *prefix,
+                               uint32_t *matches) {
+  DEBUG_ASSERT(GetPackType() == common::PackType::STR);
+  auto &dpn = get_dpn(pn);
+  if (dpn.IsLocal() && !dpn.NullOnly()) {
+    LockPackForUse(pn);
+  } else if (dpn.NullOnly() || !dpn.IncRef()) {  // not in memory, read the stored pack
+    if (!prefix || PackStr::ProjectsPrefix(dpn, m_share)) {
+      PackStr::LoadProjection(dpn, m_share, nulls, lens, prefix, matches);
+      return;
+    }
+    LockPackForUse(pn);  // the prefixes are in the compressed values
+  }
+  auto p = get_packS(pn);
+  std::memset(nulls, 0, (1 << pss) / 8);
+  if (prefix) std::memset(matches, 0, (1 << pss) / 8);
+  for (uint i = 0; i < dpn.nr; i++) {
+    if (p->IsNull(i)) {
+      nulls[i >> 5] |= (uint32_t(1) << (i % 32));
+      if (lens) lens[i] = 0;
+      continue;
+    }
+    types::BString v(p->GetValueBinary(i));
+    if (lens) lens[i] = v.size();
+    if (prefix && v.size() >= prefix->size() &&
+        std::memcmp(v.GetDataBytesPointer(), prefix->GetDataBytesPointer(), prefix->size()) == 0)
+      matches[i >> 5] |= (uint32_t(1) << (i % 32));
+  }
+  UnlockPackFromUse(pn);
+}
+
 void RCAttr::Collapse() {
   if (m_dict && !m_dict->Changed()) {
     m_dict->Release();
@@ -811,6 +936,10 @@ void RCAttr::PreparePackForLoad() {
 }
 
 void RCAttr::LoadData(loader::ValueCache *nvs, Transaction *conn_info) {
+  if (auto pack = LoadPackValues(nvs, conn_info)) pack->Save();
+}
+
+Pack *RCAttr::LoadPackValues(loader::ValueCache *nvs, Transaction *conn_info) {
   no_change = false;
   if (conn_info) current_tx = conn_info;
 
@@ -829,11 +958,11 @@ void RCAttr::LoadData(loader::ValueCache *nvs, Transaction *conn_info) {
       break;
   }
 
-  if (!get_dpn(pi).Trivial()) get_pack(pi)->Save();
-
   hdr.nr += nvs->NumOfValues();
   hdr.nn += (Type().NotNull() ? 0 : nvs->NumOfNulls());
   hdr.natural_size += nvs->SumarizedSize();
+
+  return get_dpn(pi).Trivial() ? nullptr : get_pack(pi);
 }
 
 void RCAttr::LoadDataPackN(size_t pi, loader::ValueCache *nvs) {
@@ -43,6 +43,9 @@
 #include "util/fs.h"
 
 namespace stonedb {
+namespace index {
+class RCTableIndex;
+}  // namespace index
 namespace core {
 class Transaction;
 class Filter;
@@ -140,6 +143,8 @@ class RCAttr final : public mm::TraceableObject, public PhysicalColumn, public P
     return dpn.min_i;
   }
 
+  void GetValuesInt64(int64_t *rows_values, size_t n) const override;
+
   bool IsNull(int64_t obj) const override {
     if (obj == common::NULL_VALUE_64) return true;
     DEBUG_ASSERT(hdr.nr >= static_cast<uint64_t>(obj));
@@ -186,6 +191,13 @@ class RCAttr final : public mm::TraceableObject, public PhysicalColumn, public P
   void LockPackForUse(common::PACK_INDEX pi);
   void UnlockPackFromUse(common::PACK_INDEX pi);
 
+  // Null mask (and value lengths, if 'lens' is not null) of a string pack; no
+  // need to lock the pack, the values are not decompressed unless the pack is
+  // in memory anyway. With a 'prefix', 'matches' gets the mask of the rows
+  // starting with it; the pack is loaded if its format cannot give it.
+  void GetPackProjection(common::PACK_INDEX pi, uint32_t *nulls, uint32_t *lens,
+                         const types::BString *prefix = nullptr, uint32_t *matches = nullptr);
+
   void CopyPackForWrite(common::PACK_INDEX pi);
 
   void Release() override;
@@ -247,6 +259,9 @@ class RCAttr final : public mm::TraceableObject, public PhysicalColumn, public P
   // Query execution
   void EvaluatePack(MIUpdatingIterator &mit, int dim, Descriptor &desc) override;
   common::ErrorCode EvaluateOnIndex(MIUpdatingIterator &mit, int dim, Descriptor &desc, int64_t limit) override;
+  // the primary key index of the table if this column is its only key column,
+  // nullptr otherwise
+  std::shared_ptr<index::RCTableIndex> GetKeyIndex();
   bool TryToMerge(Descriptor &d1,
                   Descriptor &d2) override;  // true, if d2 is no longer needed
 
@@ -292,12 +307,22 @@ class RCAttr final : public mm::TraceableObject, public PhysicalColumn, public P
   std::vector<int64_t> GetListOfDistinctValuesInPack(int pack) override;
 
   void LoadData(loader::ValueCache *nvs, Transaction *conn_info = NULL);
+  // The first step of LoadData(): put the values into the last pack and return
+  // the pack to be saved (nullptr for a trivial pack). Saving it may overlap
+  // with loading of the next pack of the column.
+  Pack *LoadPackValues(loader::ValueCache *nvs, Transaction *conn_info = NULL);
   void LoadPackInfo(Transaction *trans = current_tx);
   void LoadProcessedData([[maybe_unused]] std::unique_ptr<system::Stream> &s,
                          [[maybe_unused]] size_t no_rows){/* TODO */};
   void PreparePackForLoad();
 
   bool SaveVersion();  // return true iff there was any change
+  // Recompute the rough filters of packs from the pack data; the new filters
+  // are saved with the next SaveVersion(). BeginFilterRebuild() runs first,
+  // single threaded, and returns false if the column has no filters; then
+  // RebuildFilters() may run concurrently on disjoint pack ranges.
+  bool BeginFilterRebuild(common::PACK_INDEX no_pack);
+  void RebuildFilters(common::PACK_INDEX from, common::PACK_INDEX to);
   void Rollback();
   void PostCommit();
 
@@ -306,6 +331,9 @@ class RCAttr final : public mm::TraceableObject, public PhysicalColumn, public P
   std::shared_ptr<Pack> Fetch(const PackCoordinate &coord) override;
   std::shared_ptr<FTree> Fetch(const FTreeCoordinate &coord) override;
   uint32_t ColId() const { return m_share->col_id; }
+  int TableId() const { return m_tid; }
+  common::TX_ID GetVersion() const { return m_version; }
+  bool IsChanged() const { return !no_change; }  // uncommitted changes of this transaction
 
  private:
   void LoadVersion(common::TX_ID xid);
@@ -17,6 +17,7 @@
 
 #include <dirent.h>
 #include <time.h>
+#include <algorithm>
 #include <fstream>
 
 #include "common/common_definitions.h"
@@ -159,7 +160,8 @@ void RCTable::Truncate() {
   m_mem_table->Truncate(m_tx);
 }
 
-RCTable::RCTable(std::string const &p, TableShare *s, Transaction *tx) : share(s), m_tx(tx), m_path(p) {
+RCTable::RCTable(std::string const &p, TableShare *s, Transaction *tx)
+    : share(s), m_tx(tx), m_path(p), m_multi_index_ready(tx == nullptr) {
   db_name = m_path.parent_path().filename().string();
 
   if (!fs::exists(m_path)) {
@@ -269,6 +271,9 @@ bool RCTable::Verify() {
 void RCTable::CommitVersion() {
   if (Verify()) throw common::DatabaseException("Data integrity is broken in table " + m_path.string());
 
+  // must run before the columns are saved, while the changed packs are still local
+  UpdateMultiIndexes();
+
   utils::result_set<bool> res;
   bool no_except = true;
   for (auto &attr : m_attrs) res.insert(rceng->load_thread_pool.add_task(&RCAttr::SaveVersion, attr.get()));
@@ -377,6 +382,163 @@ void RCTable::CommitVersion() {
 
 void RCTable::PostCommit() {
   for (auto &attr : m_attrs) attr->PostCommit();
+
+  for (auto &[n, ver] : m_multi_index_old) rceng->DeferRemove(MultiIndexPath(n) / ver.ToString(), share->TabID());
+  m_multi_index_old.clear();
+  m_multi_index_ready = true;
+
+  if (!m_rebuild_cols.empty()) SaveRebuildProgress();
+}
+
+const std::vector<MultiIndexDef> &RCTable::GetMultiIndexDefs() const { return share->GetMultiIndexDefs(); }
+
+fs::path RCTable::MultiIndexPath(size_t n) const {
+  return m_path / common::COL_FILTER_DIR / common::COL_FILTER_MULTI_DIR / std::to_string(n);
+}
+
+// the index changes together with any of its columns, so the latest version of
+// the columns identifies it
+common::TX_ID RCTable::MultiIndexVersion(size_t n) const {
+  common::TX_ID ver(0);
+  for (auto c : share->GetMultiIndexDefs()[n].cols) ver = std::max(ver, m_versions[c]);
+  return ver;
+}
+
+std::shared_ptr<RSIndex_Multi> RCTable::GetMultiIndex(size_t n) {
+  if (!stonedb_sysvar_enable_histogram_cmap_bloom || !m_multi_index_ready) return nullptr;
+
+  auto &defs = share->GetMultiIndexDefs();
+  if (n >= defs.size()) return nullptr;
+
+  std::scoped_lock guard(m_multi_index_mtx);
+  if (m_multi_indexes.empty()) m_multi_indexes.resize(defs.size());
+  if (!m_multi_indexes[n])
+    m_multi_indexes[n] = std::make_shared<RSIndex_Multi>(MultiIndexPath(n), defs[n], MultiIndexVersion(n));
+  return m_multi_indexes[n]->Loaded() ? m_multi_indexes[n] : nullptr;
+}
+
+void RCTable::UpdateMultiIndexes() {
+  auto &defs = share->GetMultiIndexDefs();
+  if (defs.empty() || !stonedb_sysvar_enable_histogram_cmap_bloom) return;
+
+  utils::result_set<bool> res;
+  for (size_t n = 0; n < defs.size(); n++)
+    res.insert(rceng->load_thread_pool.add_task(&RCTable::UpdateMultiIndex, this, n));
+
+  bool no_except = true;
+  for (size_t n = 0; n < defs.size(); n++) {
+    try {
+      if (res.get(n)) m_multi_index_old.emplace_back(n, MultiIndexVersion(n));
+    } catch (std::exception &e) {
+      no_except = false;
+      STONEDB_LOG(LogCtl_Level::ERROR, "An exception is caught: %s", e.what());
+    } catch (...) {
+      no_except = false;
+      STONEDB_LOG(LogCtl_Level::ERROR, "An unknown system exception error caught.");
+    }
+  }
+  if (!no_except) {
+    throw common::Exception("Parallel update of rough indexes failed.");
+  }
+}
+
+// Rebuild the entries of the packs changed in this transaction (all packs if
+// there is no valid previous version) and save the index as a new version.
+bool RCTable::UpdateMultiIndex(size_t n) {
+  auto &def = share->GetMultiIndexDefs()[n];
+  std::vector<RCAttr *> attrs;
+  bool changed = false;
+  for (auto c : def.cols) {
+    auto attr = m_attrs[c].get();
+    attrs.push_back(attr);
+    changed = changed || !attr->no_change;
+    for (size_t pi = 0; !changed && pi < attr->m_idx.size(); pi++) changed = attr->get_dpn(pi).IsLocal();
+  }
+  bool in_rebuild = std::any_of(def.cols.begin(), def.cols.end(),
+                                [this](auto c) { return c < m_rebuild_cols.size() && m_rebuild_cols[c]; });
+  if (!changed) return false;
+
+  auto idx = std::make_shared<RSIndex_Multi>(MultiIndexPath(n), def, MultiIndexVersion(n));
+  bool rebuild = !idx->Loaded();
+  int no_pack = attrs[0]->SizeOfPack();
+  idx->Resize(no_pack);
+  for (int pi = 0; pi < no_pack; pi++) {
+    bool local = false;
+    for (auto attr : attrs) local = local || attr->get_dpn(pi).IsLocal();
+    if (!local && !rebuild && !(in_rebuild && pi >= int(m_rebuild_from) && pi < int(m_rebuild_to))) continue;
+
+    // local packs are loaded already
+    std::vector<std::unique_ptr<DataPackLock>> locks;
+    for (auto attr : attrs)
+      if (!attr->get_dpn(pi).IsLocal()) locks.emplace_back(std::make_unique<DataPackLock>(attr, pi));
+    idx->Update(pi, attrs, uint64_t(pi) << Getpackpower(), attrs[0]->get_dpn(pi).nr);
+  }
+  idx->SaveToFile(m_tx->GetID());
+  return true;
+}
+
+bool RCTable::RebuildRoughIndexes(std::vector<bool> cols, size_t max_packs, int threads) {
+  ASSERT(m_tx != nullptr, "Attempt to modify table in read-only transaction");
+  if (cols.empty()) cols.assign(m_attrs.size(), true);
+
+  // the progress file holds the next pack and the columns of an unfinished rebuild
+  std::string mask;
+  for (auto c : cols) mask += (c ? '1' : '0');
+  common::PACK_INDEX from = 0;
+  {
+    std::ifstream ifs(m_path / common::TABLE_REBUILD_FILE);
+    common::PACK_INDEX next;
+    std::string saved;
+    if (ifs >> next >> saved && saved == mask) from = next;
+  }
+  common::PACK_INDEX no_pack = m_attrs.empty() ? 0 : m_attrs[0]->SizeOfPack();
+  if (from >= no_pack) from = 0;  // the table was truncated meanwhile
+  common::PACK_INDEX to = no_pack;
+  if (max_packs > 0 && from + max_packs < no_pack) to = from + max_packs;
+
+  m_rebuild_cols = cols;
+  m_rebuild_from = from;
+  m_rebuild_to = to;
+  STONEDB_LOG(LogCtl_Level::INFO, "Rebuilding rough indexes of %s, packs %u - %u of %u", m_path.c_str(), from, to,
+              no_pack);
+
+  // a rebuilt multi-column index needs a new version of its columns
+  for (auto &def : share->GetMultiIndexDefs())
+    for (auto c : def.cols)
+      if (cols[c]) m_attrs[c]->no_change = false;
+
+  if (threads < 1) threads = 1;
+  for (size_t i = 0; i < m_attrs.size(); i++) {
+    if (!cols[i] || from == to) continue;
+    auto attr = m_attrs[i].get();
+    if (!attr->BeginFilterRebuild(to)) continue;
+
+    // one column at a time, so at most 'threads' workers load packs
+    common::PACK_INDEX chunk = (to - 1 - from + threads - 1) / threads;
+    utils::result_set<void> res;
+    for (auto b = from; chunk > 0 && b < to - 1; b += chunk)
+      res.insert(rceng->load_thread_pool.add_task(&RCAttr::RebuildFilters, attr, b, std::min(b + chunk, to - 1)));
+    try {
+      res.get_all_with_except();
+    } catch (...) {
+      if (m_tx->Killed()) throw common::KilledException();
+      throw;
+    }
+  }
+  return to == no_pack;
+}
+
+void RCTable::SaveRebuildProgress() {
+  auto p = m_path / common::TABLE_REBUILD_FILE;
+  common::PACK_INDEX no_pack = m_attrs.empty() ? 0 : m_attrs[0]->SizeOfPack();
+  if (m_rebuild_to >= no_pack) {
+    fs::remove(p);
+    return;
+  }
+  std::ofstream ofs(p.string(), std::ios::trunc);
+  ofs << m_rebuild_to << ' ';
+  for (auto c : m_rebuild_cols) ofs << (c ? '1' : '0');
+  if (!ofs) STONEDB_LOG(LogCtl_Level::WARN, "Failed to save the rebuild progress of %s", m_path.c_str());
 }
 
 void RCTable::Rollback([[maybe_unused]] common::TX_ID xid, bool) {
@@ -733,23 +895,55 @@ uint64_t RCTable::ProceedNormal(system::IOParameters &iop) {
 
   loader::LoadParser parser(m_attrs, iop, share->PackSize(), fs);
 
+  // The load is pipelined: while this thread parses a pack row, the loader
+  // threads put the previous one into the columns and compress and write the
+  // one before it. The saves are waited for only after the parsing, so at most
+  // three pack rows are held.
   uint to_prepare;
   uint no_of_rows_returned;
+  int64_t no_obj = m_attrs[0]->NumOfObj();
+  bool first_load = (no_obj == 0);
+  std::vector<loader::ValueCache> loading_buffers;
+  utils::result_set<Pack *> loading;
+  utils::result_set<void> saving;
+  auto start_saving = [&loading, &saving]() {
+    for (uint att = 0; att < loading.size(); ++att)
+      if (auto pack = loading.get(att)) saving.insert(rceng->load_thread_pool.add_task(&Pack::Save, pack));
+    loading = {};
+  };
+  // no exception may leave with tasks running on the buffers
+  std::shared_ptr<void> defer(nullptr, [&loading, &saving](...) {
+    loading.wait_all();
+    saving.wait_all();
+  });
+
   utils::Timer timer;
   do {
-    to_prepare = share->PackSize() - (m_attrs[0]->NumOfObj() % share->PackSize());
+    to_prepare = share->PackSize() - (no_obj % share->PackSize());
     std::vector<loader::ValueCache> value_buffers;
     no_of_rows_returned = parser.GetPackrow(to_prepare, value_buffers);
     no_dup_rows += parser.GetDuprow();
+    if (first_load && parser.GetNoRow() > 0) {
+      AdviseLookup(value_buffers);
+      first_load = false;
+    }
+
+    saving.get_all();
+    saving = {};
+    start_saving();
+    loading_buffers = std::move(value_buffers);
     if (parser.GetNoRow() > 0) {
-      utils::result_set<void> res;
-      for (uint att = 0; att < m_attrs.size(); ++att) {
-        res.insert(
-            rceng->load_thread_pool.add_task(&RCAttr::LoadData, m_attrs[att].get(), &value_buffers[att], current_tx));
-      }
-      res.get_all();
+      // the last pack row was not filled up (duplicates skipped) and its packs
+      // are continued, so they must be saved before
+      if (no_obj % share->PackSize() != 0) saving.wait_all();
+      no_obj += loading_buffers[0].NumOfValues();
+      for (uint att = 0; att < m_attrs.size(); ++att)
+        loading.insert(rceng->load_thread_pool.add_task(&RCAttr::LoadPackValues, m_attrs[att].get(),
+                                                        &loading_buffers[att], current_tx));
     }
   } while (no_of_rows_returned == to_prepare);
+  start_saving();
+  saving.get_all();
 
   auto no_loaded_rows = parser.GetNoRow();
 
@@ -771,6 +965,33 @@ uint64_t RCTable::ProceedNormal(system::IOParameters &iop) {
   return no_loaded_rows;
 }
 
+void RCTable::AdviseLookup(const std::vector<loader::ValueCache> &vcs) {
+  // The format of a column is fixed when the table is created, so a column
+  // which would be better stored as dictionary codes is only reported.
+  if (stonedb_sysvar_lookup_advice == 0) return;
+  THD *thd = current_tx->Thd();
+  TABLE *table = thd->lex->select_lex->table_list.first ? thd->lex->select_lex->table_list.first->table : nullptr;
+  std::string tab_name = db_name + "." + (table ? std::string(table->s->table_name.str) : m_path.stem().string());
+  for (uint att = 0; att < m_attrs.size(); ++att) {
+    auto &ct = m_attrs[att]->Type();
+    if (ct.GetFmt() != common::PackFmt::DEFAULT ||
+        (ct.GetTypeName() != common::CT::STRING && ct.GetTypeName() != common::CT::VARCHAR))
+      continue;
+    auto &vc = vcs[att];
+    size_t not_null = vc.NumOfValues() - vc.NumOfNulls();
+    size_t distinct = vc.NumOfDistinct(stonedb_sysvar_lookup_advice, ct.GetCollation());
+    // a dictionary pays off only if values repeat a lot
+    if (distinct == 0 || distinct > stonedb_sysvar_lookup_advice || distinct * 16 > not_null) continue;
+
+    std::string col_name = (table && att < table->s->fields) ? table->field[att]->field_name : std::to_string(att);
+    std::string msg = "Column " + tab_name + "." + col_name + " has " + std::to_string(distinct) +
+                      " distinct values in the first " + std::to_string(vc.NumOfValues()) +
+                      " rows loaded; COMMENT 'LOOKUP' would store it as dictionary codes";
+    push_warning(thd, Sql_condition::SL_NOTE, ER_UNKNOWN_ERROR, msg.c_str());
+    rccontrol.lock(current_tx->GetThreadID()) << msg << system::unlock;
+  }
+}
+
 int RCTable::binlog_load_query_log_event(system::IOParameters &iop) {
   char *load_data_query, *end, *fname_start, *fname_end, *p = NULL;
   size_t pl = 0;
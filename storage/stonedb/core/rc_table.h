@@ -18,12 +18,14 @@
 #define STONEDB_CORE_RC_TABLE_H_
 #pragma once
 
+#include <mutex>
 #include <string>
 
 #include "common/common_definitions.h"
 #include "core/just_a_table.h"
 #include "core/rc_attr.h"
 #include "core/rc_mem_table.h"
+#include "core/rsi_multi.h"
 #include "util/fs.h"
 
 namespace stonedb {
@@ -96,6 +98,17 @@ class RCTable final : public JustATable {
   void Rollback(common::TX_ID xid, bool = false);
   void PostCommit();
 
+  // rough index of the n-th ROUGH_INDEX(...) declaration of the table, nullptr
+  // if it is not available for this version
+  std::shared_ptr<RSIndex_Multi> GetMultiIndex(size_t n);
+  const std::vector<MultiIndexDef> &GetMultiIndexDefs() const;
+
+  // OPTIMIZE TABLE: rebuild the rough filters of the columns 'cols' (all
+  // columns if empty) and the multi-column rough indexes over them. At most
+  // 'max_packs' packs (0: no limit) are done per call, the next call resumes
+  // where the last committed one stopped. Returns true if all packs are done.
+  bool RebuildRoughIndexes(std::vector<bool> cols, size_t max_packs, int threads);
+
   // Data access & information
   int64_t NumOfObj() override;
   int64_t NumOfValues() { return NumOfObj(); }
@@ -131,10 +144,16 @@ class RCTable final : public JustATable {
   uint64_t ProceedNormal(system::IOParameters &iop);
   uint64_t ProcessDelayed(system::IOParameters &iop);
   void Field2VC(Field *f, loader::ValueCache &vc, size_t col);
+  void AdviseLookup(const std::vector<loader::ValueCache> &vcs);
   int binlog_load_query_log_event(system::IOParameters &iop);
   int binlog_insert2load_log_event(system::IOParameters &iop);
   int binlog_insert2load_block(std::vector<loader::ValueCache> &vcs, uint load_obj, system::IOParameters &iop);
   size_t max_row_length(std::vector<loader::ValueCache> &vcs, uint row, uint delimiter);
+  void UpdateMultiIndexes();
+  bool UpdateMultiIndex(size_t n);
+  fs::path MultiIndexPath(size_t n) const;
+  common::TX_ID MultiIndexVersion(size_t n) const;
+  void SaveRebuildProgress();
 
  private:
   TableShare *share;
@@ -147,6 +166,19 @@ class RCTable final : public JustATable {
 
   std::vector<common::TX_ID> m_versions;
 
+  // multi-column rough indexes: loaded on demand in read-only versions; the
+  // index files replaced by the commit of a write version
+  std::vector<std::shared_ptr<RSIndex_Multi>> m_multi_indexes;
+  std::mutex m_multi_index_mtx;
+  std::vector<std::pair<size_t, common::TX_ID>> m_multi_index_old;
+  bool m_multi_index_ready;
+
+  // packs [m_rebuild_from, m_rebuild_to) of m_rebuild_cols are rebuilt by this
+  // write version
+  std::vector<bool> m_rebuild_cols;
+  common::PACK_INDEX m_rebuild_from = 0;
+  common::PACK_INDEX m_rebuild_to = 0;
+
   fs::path m_path;
 
   size_t no_rejected_rows = 0;
@@ -103,6 +103,14 @@ common::ErrorCode RCAttr::EvaluateOnIndex(MIUpdatingIterator &mit, int dim, Desc
 
   return rv;
 }
+
+std::shared_ptr<index::RCTableIndex> RCAttr::GetKeyIndex() {
+  auto indextab = rceng->GetTableIndex(m_share->owner->Path());
+  if (!indextab) return nullptr;
+  std::vector<uint> keycols = indextab->KeyCols();
+  return (keycols.size() == 1 && keycols[0] == ColId()) ? indextab : nullptr;
+}
+
 common::ErrorCode RCAttr::EvaluateOnIndex_BetweenInt(MIUpdatingIterator &mit, int dim, Descriptor &d, int64_t limit) {
   common::ErrorCode rv = common::ErrorCode::FAILED;
   auto indextab = rceng->GetTableIndex(m_share->owner->Path());
@@ -296,8 +304,16 @@ void RCAttr::EvaluatePack_IsNull(MIUpdatingIterator &mit, int dim) {
   }
   auto const &dpn(get_dpn(pack));
   if (!dpn.Trivial() && dpn.nn != 0) {  // nontrivial pack exists
+    std::unique_ptr<uint32_t[]> str_nulls;
+    if (GetPackType() == common::PackType::STR) {  // the values are not needed, read the null mask only
+      str_nulls.reset(new uint32_t[(1 << pss) / 32]);
+      GetPackProjection(pack, str_nulls.get(), nullptr);
+    }
     do {
-      if (mit[dim] != common::NULL_VALUE_64 && !get_pack(pack)->IsNull(mit.GetCurInpack(dim))) mit.ResetCurrent();
+      int inpack = mit.GetCurInpack(dim);
+      bool is_null = (str_nulls ? (str_nulls[inpack >> 5] & (uint32_t(1) << (inpack % 32))) != 0
+                                : get_pack(pack)->IsNull(inpack));
+      if (mit[dim] != common::NULL_VALUE_64 && !is_null) mit.ResetCurrent();
       ++mit;
     } while (mit.IsValid() && !mit.PackrowStarted());
   } else {  // pack is trivial - uniform or null only
@@ -324,8 +340,16 @@ void RCAttr::EvaluatePack_NotNull(MIUpdatingIterator &mit, int dim) {
   }
   auto const &dpn(get_dpn(pack));
   if (!dpn.Trivial() && dpn.nn != 0) {
+    std::unique_ptr<uint32_t[]> str_nulls;
+    if (GetPackType() == common::PackType::STR) {  // as in EvaluatePack_IsNull()
+      str_nulls.reset(new uint32_t[(1 << pss) / 32]);
+      GetPackProjection(pack, str_nulls.get(), nullptr);
+    }
     do {
-      if (mit[dim] == common::NULL_VALUE_64 || get_pack(pack)->IsNull(mit.GetCurInpack(dim))) mit.ResetCurrent();
+      int inpack = mit.GetCurInpack(dim);
+      bool is_null = (str_nulls ? (str_nulls[inpack >> 5] & (uint32_t(1) << (inpack % 32))) != 0
+                                : get_pack(pack)->IsNull(inpack));
+      if (mit[dim] == common::NULL_VALUE_64 || is_null) mit.ResetCurrent();
       ++mit;
     } while (mit.IsValid() && !mit.PackrowStarted());
   } else {  // pack is trivial - uniform or null only
@@ -351,14 +375,29 @@ void RCAttr::EvaluatePack_Like(MIUpdatingIterator &mit, int dim, Descriptor &d)
     mit.NextPackrow();
     return;
   }
+  types::BString pattern;
+  d.val1.vc->GetValueString(pattern, mit);
+  if (d.IsLikePrefix(pattern)) {  // 'abc%' needs no values, the pack may not be loaded
+    std::unique_ptr<uint32_t[]> str_nulls(new uint32_t[(1 << pss) / 32]);
+    std::unique_ptr<uint32_t[]> matches(new uint32_t[(1 << pss) / 32]);
+    types::BString prefix(pattern.GetDataBytesPointer(), pattern.size() - 1);
+    GetPackProjection(pack, str_nulls.get(), nullptr, &prefix, matches.get());
+    do {
+      int inpack = mit.GetCurInpack(dim);
+      uint32_t bit = uint32_t(1) << (inpack % 32);
+      if (mit[dim] == common::NULL_VALUE_64 || (str_nulls[inpack >> 5] & bit) != 0 ||
+          ((matches[inpack >> 5] & bit) != 0) == (d.op == common::Operator::O_NOT_LIKE))
+        mit.ResetCurrent();
+      ++mit;
+    } while (mit.IsValid() && !mit.PackrowStarted());
+    return;
+  }
   auto p = get_packS(pack);
   if (p == NULL) {  // => nulls only
     mit.ResetCurrentPack();
     mit.NextPackrow();
     return;
   }
-  types::BString pattern;
-  d.val1.vc->GetValueString(pattern, mit);
   size_t min_len = 0;  // the number of fixed characters
   for (uint i = 0; i < pattern.len; i++) {
     if (pattern[i] != '%') min_len++;
@@ -86,7 +86,7 @@ void RSIndex_Bloom::Update(common::PACK_INDEX pi, DPN &dpn, const PackStr *pack)
     hdr.no_pack = pi + 1;
   }
   if (hdr.no_pack > capacity) {
-    capacity += 1024;
+    capacity = (hdr.no_pack / 1024 + 1) * 1024;  // pi may jump past the current end
     bloom_buffers =
         static_cast<BF *>(rc_realloc(bloom_buffers, capacity * sizeof(BF), mm::BLOCK_TYPE::BLOCK_TEMPORARY));
     //  rclog << lock << "bloom filter capacity increased to " << capacity <<
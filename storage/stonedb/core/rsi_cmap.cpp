@@ -150,7 +150,7 @@ void RSIndex_CMap::Update(common::PACK_INDEX pi, DPN &dpn, const PackStr *pack)
     hdr.no_pack = pi + 1;
   }
   if (hdr.no_pack > capacity) {
-    capacity += 1024;
+    capacity = (hdr.no_pack / 1024 + 1) * 1024;  // pi may jump past the current end
     auto ptr = rc_realloc(cmap_buffers, capacity * hdr.no_positions * CMAP_BYTES, mm::BLOCK_TYPE::BLOCK_TEMPORARY);
     cmap_buffers = static_cast<uint32_t *>(ptr);
     // rclog << lock << "cmap filter capacity increased to " << capacity <<
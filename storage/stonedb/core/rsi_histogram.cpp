@@ -175,7 +175,7 @@ void RSIndex_Hist::Update(common::PACK_INDEX pi, DPN &dpn, const PackInt *pack)
     hdr.no_pack = pi + 1;
   }
   if (hdr.no_pack > capacity) {
-    capacity += 1024;
+    capacity = (hdr.no_pack / 1024 + 1) * 1024;  // pi may jump past the current end
     hist_buffers =
         static_cast<BLOCK *>(rc_realloc(hist_buffers, capacity * sizeof(BLOCK), mm::BLOCK_TYPE::BLOCK_TEMPORARY));
     // rclog << lock << "hist filter capacity increased to " << capacity <<
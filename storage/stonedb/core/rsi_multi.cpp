@@ -0,0 +1,190 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+
+#include "core/rsi_multi.h"
+#include "core/rc_attr.h"
+#include "system/rc_system.h"
+#include "system/stonedb_file.h"
+
+namespace stonedb {
+namespace core {
+std::string MultiIndexDef::ToString() const {
+  std::string s(kind == Kind::BLOOM ? "BLOOM(" : "EXPR(");
+  for (size_t i = 0; i < cols.size(); i++) {
+    if (i > 0) s += (kind == Kind::BLOOM ? ',' : op);
+    s += std::to_string(cols[i]);
+  }
+  return s + ")";
+}
+
+RSIndex_Multi::RSIndex_Multi(const fs::path &dir, const MultiIndexDef &def, common::TX_ID ver) : def(def) {
+  m_path = dir;
+  hdr.kind = int32_t(def.kind);
+  bloom_filter_policy.reset(NewBloomFilterPolicy(bits_key));
+
+  auto fpath = dir / ver.ToString();
+  if (!fs::exists(fpath)) return;
+
+  system::StoneDBFile frs_index;
+  frs_index.OpenReadOnly(fpath);
+  HDR h;
+  frs_index.ReadExact(&h, sizeof(h));
+  std::string text(h.def_len, '\0');
+  frs_index.ReadExact(text.data(), h.def_len);
+  if (h.ver != FORMAT_VERSION || h.kind != hdr.kind || text != def.ToString()) {
+    STONEDB_LOG(LogCtl_Level::WARN, "ignore rough index %s built for %s", fpath.c_str(), text.c_str());
+    return;
+  }
+
+  hdr = h;
+  if (def.kind == MultiIndexDef::Kind::BLOOM) {
+    blooms.resize(hdr.no_pack);
+    for (auto &b : blooms) {
+      uint32_t len;
+      frs_index.ReadExact(&len, sizeof(len));
+      b.resize(len);
+      frs_index.ReadExact(b.data(), len);
+    }
+  } else {
+    ranges.resize(hdr.no_pack);
+    frs_index.ReadExact(ranges.data(), hdr.no_pack * sizeof(Range));
+  }
+  loaded = true;
+}
+
+void RSIndex_Multi::SaveToFile(common::TX_ID ver) {
+  fs::create_directories(m_path);
+  auto fpath = m_path / ver.ToString();
+  ASSERT(!fs::exists(fpath), "file already exists: " + fpath.string());
+
+  auto text = def.ToString();
+  hdr.def_len = text.size();
+  system::StoneDBFile frs_index;
+  frs_index.OpenCreate(fpath);
+  frs_index.WriteExact(&hdr, sizeof(hdr));
+  frs_index.WriteExact(text.data(), text.size());
+  if (def.kind == MultiIndexDef::Kind::BLOOM) {
+    for (auto &b : blooms) {
+      uint32_t len = b.size();
+      frs_index.WriteExact(&len, sizeof(len));
+      frs_index.WriteExact(b.data(), len);
+    }
+  } else {
+    frs_index.WriteExact(ranges.data(), hdr.no_pack * sizeof(Range));
+  }
+  if (stonedb_sysvar_sync_buffers) {
+    frs_index.Flush();
+  }
+}
+
+void RSIndex_Multi::Resize(size_t no_pack) {
+  hdr.no_pack = no_pack;
+  if (def.kind == MultiIndexDef::Kind::BLOOM)
+    blooms.resize(no_pack);
+  else
+    ranges.resize(no_pack, Range{0, 0, 0});
+}
+
+void RSIndex_Multi::AppendKey(std::string &key, int64_t v) { key.append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+
+void RSIndex_Multi::AppendKey(std::string &key, const char *val, size_t len) {
+  uint32_t l = len;
+  key.append(reinterpret_cast<const char *>(&l), sizeof(l));
+  key.append(val, len);
+}
+
+bool RSIndex_Multi::Compute(char op, int64_t v1, int64_t v2, int64_t &res) {
+  switch (op) {
+    case '+':
+      return !__builtin_add_overflow(v1, v2, &res);
+    case '-':
+      return !__builtin_sub_overflow(v1, v2, &res);
+    case '*':
+      return !__builtin_mul_overflow(v1, v2, &res);
+    default:
+      return false;
+  }
+}
+
+void RSIndex_Multi::Update(common::PACK_INDEX pi, const std::vector<RCAttr *> &attrs, uint64_t first_row,
+                           size_t nr) {
+  if (pi >= hdr.no_pack) Resize(pi + 1);
+
+  if (def.kind == MultiIndexDef::Kind::EXPR) {
+    Range r{common::PLUS_INF_64, common::MINUS_INF_64, 1};
+    bool any = false;
+    for (uint64_t row = first_row; row < first_row + nr; row++) {
+      int64_t v1 = attrs[0]->GetValueInt64(row);
+      int64_t v2 = attrs[1]->GetValueInt64(row);
+      if (v1 == common::NULL_VALUE_64 || v2 == common::NULL_VALUE_64) continue;
+      int64_t v;
+      if (!Compute(def.op, v1, v2, v)) {
+        any = false;  // no information rather than a wrong one
+        break;
+      }
+      r.min = std::min(r.min, v);
+      r.max = std::max(r.max, v);
+      any = true;
+    }
+    ranges[pi] = (any ? r : Range{0, 0, 0});
+    return;
+  }
+
+  FilterBlockBuilder bloom_builder(bloom_filter_policy.get());
+  bloom_builder.StartBlock(0);
+  std::string key;
+  for (uint64_t row = first_row; row < first_row + nr; row++) {
+    key.clear();
+    bool null = false;
+    for (auto attr : attrs) {
+      if (attr->GetPackType() == common::PackType::STR) {
+        if (attr->IsNull(row)) {
+          null = true;
+          break;
+        }
+        auto s = attr->GetValueString(row);
+        AppendKey(key, s.val, s.len);
+      } else {
+        int64_t v = attr->GetValueInt64(row);
+        if (v == common::NULL_VALUE_64) {
+          null = true;
+          break;
+        }
+        AppendKey(key, v);
+      }
+    }
+    // a tuple with a null never satisfies a conjunction of equalities
+    if (!null) bloom_builder.AddKey(Slice(key));
+  }
+  Slice block = bloom_builder.Finish();
+  blooms[pi].assign(block.data(), block.size());
+}
+
+common::RSValue RSIndex_Multi::IsValue(const std::string &key, int pack) const {
+  if (pack < 0 || size_t(pack) >= blooms.size() || blooms[pack].empty()) return common::RSValue::RS_SOME;
+  FilterBlockReader reader(bloom_filter_policy.get(), Slice(blooms[pack]));
+  return reader.KeyMayMatch(0, Slice(key)) ? common::RSValue::RS_SOME : common::RSValue::RS_NONE;
+}
+
+bool RSIndex_Multi::GetRange(int pack, int64_t &min, int64_t &max) const {
+  if (pack < 0 || size_t(pack) >= ranges.size() || !ranges[pack].valid) return false;
+  min = ranges[pack].min;
+  max = ranges[pack].max;
+  return true;
+}
+}  // namespace core
+}  // namespace stonedb
@@ -0,0 +1,100 @@
+/* Copyright (c) 2022 StoneAtom, Inc. All rights reserved.
+   Use is subject to license terms
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; version 2 of the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1335 USA
+*/
+#ifndef STONEDB_CORE_RSI_MULTI_H_
+#define STONEDB_CORE_RSI_MULTI_H_
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/bloom_block.h"
+#include "core/rsi_index.h"
+
+namespace stonedb {
+namespace core {
+class RCAttr;
+
+// A rough index spanning several columns of a table, declared in the table
+// comment:
+//   ROUGH_INDEX(a,b)  - per pack bloom filter of the (a,b,...) value tuples,
+//                       for conjunctions of equalities on all the columns
+//   ROUGH_INDEX(a*b)  - per pack min/max of an integer expression of two
+//                       columns, the operator may be +, - or *
+struct MultiIndexDef {
+  enum class Kind : int32_t { BLOOM = 0, EXPR = 1 };
+  Kind kind;
+  std::vector<uint32_t> cols;  // member columns
+  char op = 0;                 // EXPR only
+
+  // canonical form, e.g. "BLOOM(0,3)" or "EXPR(1*2)", stored in the index file
+  // so that a changed declaration never uses an old file
+  std::string ToString() const;
+};
+
+class RSIndex_Multi final : public RSIndex {
+ public:
+  RSIndex_Multi(const fs::path &dir, const MultiIndexDef &def, common::TX_ID ver);
+  ~RSIndex_Multi() = default;
+
+  // false if there was no valid index file for the version
+  bool Loaded() const { return loaded; }
+  size_t NumOfPacks() const { return hdr.no_pack; }
+  void SaveToFile(common::TX_ID ver) override;
+
+  // resize to the current number of packs, new packs have no information
+  void Resize(size_t no_pack);
+  // rebuild the entry of a pack; the packs of all members must be locked
+  void Update(common::PACK_INDEX pi, const std::vector<RCAttr *> &attrs, uint64_t first_row, size_t nr);
+
+  // BLOOM: can the pack contain the tuple 'key' (see AppendKey())?
+  common::RSValue IsValue(const std::string &key, int pack) const;
+  // EXPR: range of the expression over the non-null rows of a pack
+  bool GetRange(int pack, int64_t &min, int64_t &max) const;
+
+  // tuple encoding: 8 bytes of an integer value, or a length prefixed string
+  static void AppendKey(std::string &key, int64_t v);
+  static void AppendKey(std::string &key, const char *val, size_t len);
+  // the expression value, false on overflow
+  static bool Compute(char op, int64_t v1, int64_t v2, int64_t &res);
+
+ private:
+  static const int FORMAT_VERSION = 1;
+  static const int bits_key = 7;
+
+  struct HDR final {
+    int32_t ver = FORMAT_VERSION;
+    int32_t kind;
+    uint32_t no_pack = 0;
+    uint32_t def_len = 0;  // length of MultiIndexDef::ToString() following the header
+  } hdr{};
+
+  struct Range final {
+    int64_t min;
+    int64_t max;
+    int64_t valid;  // 0 if unknown: not computed, null only or overflow
+  };
+
+  const MultiIndexDef def;
+  bool loaded = false;
+  std::vector<std::string> blooms;  // BLOOM: filter block of each pack, empty if unknown
+  std::vector<Range> ranges;        // EXPR
+  std::unique_ptr<const FilterPolicy> bloom_filter_policy;
+};
+}  // namespace core
+}  // namespace stonedb
+
+#endif  // STONEDB_CORE_RSI_MULTI_H_
@@ -125,9 +125,12 @@ void SorterWrapper::InitSorter(MultiIndex &mind, bool implicit_logic) {
     }
   }
 
-  // Identify implicitly encoded columns
+  // Identify implicitly encoded columns. If the limit discards most of the
+  // rows, output columns wider than a row position are read only for the rows
+  // which survive sorting (late materialization).
+  bool limit_cuts = (implicit_logic && limit > -1 && limit < no_of_rows);
   for (int dim = 0; dim < mind.NumOfDimensions(); dim++)
-    if (one_pack_dims[dim] && !implicit_dims[dim]) {  // potentially implicit, check sizes
+    if ((one_pack_dims[dim] || limit_cuts) && !implicit_dims[dim]) {  // potentially implicit, check sizes
       uint col_sizes_for_dim = 0;
       for (uint i = 0; i < input_cols.size(); i++) {
         if (input_cols[i].sort_order == 0 && input_cols[i].col->GetDim() == dim && scol[i].IsEnabled()) {
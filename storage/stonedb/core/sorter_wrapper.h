@@ -52,6 +52,16 @@ class SorterWrapper {
 
   int64_t GetValue64(int col, bool &is_null) { return scol[col].GetValue64(cur_val, cur_mit, is_null); }
   types::BString GetValueT(int col) { return scol[col].GetValueT(cur_val, cur_mit); }
+
+  // Implicit (late materialized) columns are not stored in the sorter, they are
+  // read from the source at a multiindex position of a sorted row
+  bool IsImplicit(int col) const { return scol[col].IsImplicit(); }
+  bool HasImplicitColumns() const { return mi_encoder != NULL; }
+  const MIDummyIterator &GetCurrentPosition() const { return cur_mit; }
+  int64_t GetValue64(int col, const MIDummyIterator &pos, bool &is_null) {
+    return scol[col].GetValue64(NULL, pos, is_null);
+  }
+  types::BString GetValueT(int col, const MIDummyIterator &pos) { return scol[col].GetValueT(NULL, pos); }
   void SortRoughly(std::vector<PackOrderer> &po);
   Sorter3 *GetSorter() { return s; }
 
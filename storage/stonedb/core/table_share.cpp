@@ -19,6 +19,8 @@
 #include <fstream>
 #include <mutex>
 
+#include <boost/algorithm/string.hpp>
+
 #include "core/rc_table.h"
 #include "core/table_share.h"
 
@@ -50,6 +52,7 @@ TableShare::TableShare(const fs::path &table_path, const TABLE_SHARE *table_shar
     m_columns.emplace_back(std::make_unique<ColumnShare>(
         this, xid, i, table_path / common::COLUMN_DIR / std::to_string(i), table_share->field[i]));
   }
+  ParseMultiIndexDefs(table_share);
 
   thr_lock_init(&thr_lock);
 }
@@ -66,6 +69,59 @@ TableShare::~TableShare() {
     if (!t.expired()) STONEDB_LOG(LogCtl_Level::FATAL, "TableShare still has ref outside by old versions");
 }
 
+void TableShare::ParseMultiIndexDefs(const TABLE_SHARE *table_share) {
+  static const std::string tag = "ROUGH_INDEX(";
+  std::string comment(table_share->comment.str, table_share->comment.length);
+  std::string str = boost::to_upper_copy(comment);
+
+  for (auto pos = str.find(tag); pos != std::string::npos; pos = str.find(tag, pos)) {
+    pos += tag.size();
+    auto end = str.find(')', pos);
+    if (end == std::string::npos) break;
+    std::string body = comment.substr(pos, end - pos);
+    pos = end;
+
+    MultiIndexDef def;
+    std::vector<std::string> names;
+    auto op_pos = body.find_first_of("+-*");
+    if (op_pos == std::string::npos) {
+      def.kind = MultiIndexDef::Kind::BLOOM;
+      boost::split(names, body, boost::is_any_of(","));
+    } else {
+      def.kind = MultiIndexDef::Kind::EXPR;
+      def.op = body[op_pos];
+      names = {body.substr(0, op_pos), body.substr(op_pos + 1)};
+    }
+
+    bool ok = names.size() >= 2;
+    for (auto &name : names) {
+      boost::trim_if(name, boost::is_any_of(" `"));
+      uint i = 0;
+      while (i < no_cols && !boost::iequals(name, table_share->field[i]->field_name)) i++;
+      if (i == no_cols || std::find(def.cols.begin(), def.cols.end(), i) != def.cols.end()) {
+        ok = false;
+        break;
+      }
+      auto &ct = m_columns[i]->ColType();
+      if (def.kind == MultiIndexDef::Kind::EXPR) {
+        // values are combined as stored, so only plain signed integers qualify
+        ok = ct.IsInt() && !ct.IsLookup() && !(table_share->field[i]->flags & UNSIGNED_FLAG);
+      } else {
+        // the same restrictions as the bloom filter of a single column
+        ok = !ct.IsFloat() && !(ct.IsString() && !ct.IsLookup() && types::RequiresUTFConversions(ct.GetCollation()));
+      }
+      if (!ok) break;
+      def.cols.push_back(i);
+    }
+    if (!ok) {
+      STONEDB_LOG(LogCtl_Level::WARN, "Ignore rough index declaration ROUGH_INDEX(%s) of %s", body.c_str(),
+                  table_path.c_str());
+      continue;
+    }
+    multi_index_defs.push_back(def);
+  }
+}
+
 std::shared_ptr<RCTable> TableShare::GetSnapshot() {
   std::scoped_lock guard(current_mtx);
   if (!current) current = std::make_shared<RCTable>(table_path, this);
@@ -21,6 +21,7 @@
 #include "common/common_definitions.h"
 #include "common/defs.h"
 #include "core/column_share.h"
+#include "core/rsi_multi.h"
 
 #include <list>
 #include <mutex>
@@ -62,17 +63,21 @@ class TableShare final {
   unsigned long GetUpdateTime();
 
   ColumnShare *GetColumnShare(size_t i) { return m_columns[i].get(); }
+  const std::vector<MultiIndexDef> &GetMultiIndexDefs() const { return multi_index_defs; }
   void CommitWrite(RCTable *t);
   void Reset();
   // MySQL lock
   THR_LOCK thr_lock;
 
  private:
+  void ParseMultiIndexDefs(const TABLE_SHARE *table_share);
+
   TABLE_META meta;
   size_t no_cols;
   fs::path table_path;
 
   std::vector<std::unique_ptr<ColumnShare>> m_columns;
+  std::vector<MultiIndexDef> multi_index_defs;  // ROUGH_INDEX(...) of the table comment
 
   std::shared_ptr<RCTable> current;
   std::mutex current_mtx;
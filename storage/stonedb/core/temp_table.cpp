@@ -81,6 +81,8 @@ TempTable::Attr::Attr(const Attr &a) : PhysicalColumn(a) {
   page_size = a.page_size;
   orig_precision = a.orig_precision;
   not_complete = a.not_complete;
+  window = a.window;
+  window_arg = a.window_arg;
   si = a.si;
 }
 
@@ -132,6 +134,8 @@ TempTable::Attr &TempTable::Attr::operator=(const TempTable::Attr &a) {
   page_size = a.page_size;
   orig_precision = a.orig_precision;
   not_complete = a.not_complete;
+  window = a.window;
+  window_arg = a.window_arg;
   return *this;
 }
 
@@ -183,27 +187,103 @@ void TempTable::Attr::CreateBuffer(uint64_t size, Transaction *conn, bool not_c)
 }
 
 void TempTable::Attr::FillValue(const MIIterator &mii, size_t idx) {
+  no_materialized = idx + 1;
+  no_obj = int64_t(idx) >= no_obj ? idx + 1 : no_obj;
+  PutValue(term.vc, mii, idx);
+}
+
+void TempTable::Attr::PutValue(vcolumn::VirtualColumn *vc, const MIIterator &mii, size_t idx) {
   types::BString vals;
   switch (TypeName()) {
     case common::CT::STRING:
     case common::CT::VARCHAR:
-      term.vc->GetValueString(vals, mii);
-      SetValueString(idx, vals);
+      vc->GetValueString(vals, mii);
+      PutValueString(idx, vals);
       break;
     case common::CT::BIN:
     case common::CT::BYTE:
     case common::CT::VARBYTE:
     case common::CT::LONGTEXT:
-      if (!term.vc->IsNull(mii))
-        term.vc->GetNotNullValueString(vals, mii);
+      if (!vc->IsNull(mii))
+        vc->GetNotNullValueString(vals, mii);
       else
         vals = types::BString();
-      SetValueString(idx, vals);
+      PutValueString(idx, vals);
       break;
     default:
-      SetValueInt64(idx, term.vc->GetValueInt64(mii));
+      PutValueInt64(idx, vc->GetValueInt64(mii));
+      break;
+  }
+}
+
+size_t TempTable::Attr::FillRange(MIIterator &mii, size_t start, size_t count, vcolumn::VirtualColumn *vc) {
+  size_t n = 0;
+  bool first_row_for_vc = true;
+  bool numeric = !ATI::IsStringType(TypeName());
+  int64_t vals[1024];
+  while (mii.IsValid() && n < count) {
+    if (mii.PackrowStarted() || first_row_for_vc) {
+      vc->LockSourcePacks(mii);
+      first_row_for_vc = false;
+    }
+    if (numeric) {
+      // a batch never crosses a packrow, so the packs locked above stay valid
+      size_t got = vc->GetValuesInt64(mii, vals, std::min(count - n, sizeof(vals) / sizeof(vals[0])));
+      for (size_t i = 0; i < got; i++) PutValueInt64(start + n + i, vals[i]);
+      n += got;
+      continue;
+    }
+    PutValue(vc, mii, start + n);
+    ++mii;
+    ++n;
+  };
+  vc->UnlockSourcePacks();
+  return n;
+}
+
+bool TempTable::Attr::LoadBufferPage(int64_t start, int64_t end) {
+  if (end <= start || start / page_size != (end - 1) / page_size) return false;
+  switch (TypeName()) {
+    case common::CT::INT:
+    case common::CT::MEDIUMINT:
+      (*(AttrBuffer<int> *)buffer)[start];
+      break;
+    case common::CT::BYTEINT:
+      (*(AttrBuffer<char> *)buffer)[start];
+      break;
+    case common::CT::SMALLINT:
+      (*(AttrBuffer<short> *)buffer)[start];
+      break;
+    case common::CT::STRING:
+    case common::CT::VARCHAR:
+    case common::CT::BIN:
+    case common::CT::BYTE:
+    case common::CT::VARBYTE:
+    case common::CT::LONGTEXT:
+      (*(AttrBuffer<types::BString> *)buffer)[start];
+      break;
+    case common::CT::BIGINT:
+    case common::CT::NUM:
+    case common::CT::YEAR:
+    case common::CT::TIME:
+    case common::CT::DATE:
+    case common::CT::DATETIME:
+    case common::CT::TIMESTAMP:
+      (*(AttrBuffer<int64_t> *)buffer)[start];
       break;
+    case common::CT::REAL:
+    case common::CT::FLOAT:
+      (*(AttrBuffer<double> *)buffer)[start];
+      break;
+    default:
+      return false;
   }
+  return true;
+}
+
+void TempTable::Attr::SetFilled(int64_t end) {
+  no_materialized = end;
+  no_obj = end > no_obj ? end : no_obj;
 }
 
 size_t TempTable::Attr::FillValues(MIIterator &mii, size_t start, size_t count) {
@@ -265,6 +345,10 @@ void TempTable::Attr::DeleteBuffer() {
 void TempTable::Attr::SetValueInt64(int64_t obj, int64_t val) {
   no_materialized = obj + 1;
   no_obj = obj >= no_obj ? obj + 1 : no_obj;
+  PutValueInt64(obj, val);
+}
+
+void TempTable::Attr::PutValueInt64(int64_t obj, int64_t val) {
   switch (TypeName()) {
     case common::CT::BIGINT:
     case common::CT::NUM:
@@ -377,6 +461,10 @@ void TempTable::Attr::SetPlusInf(int64_t obj) { SetValueInt64(obj, common::PLUS_
 void TempTable::Attr::SetValueString(int64_t obj, const types::BString &val) {
   no_materialized = obj + 1;
   no_obj = obj >= no_obj ? obj + 1 : no_obj;
+  PutValueString(obj, val);
+}
+
+void TempTable::Attr::PutValueString(int64_t obj, const types::BString &val) {
   int64_t val64 = 0;
   double valD = 0.0;
 
@@ -891,6 +979,7 @@ TempTable::TempTable(const TempTable &t, bool is_vc_owner)
   tables = t.tables;
   join_types = t.join_types;
   order_by = t.order_by;
+  windows = t.windows;
   has_temp_table = t.has_temp_table;
   lazy = t.lazy;
   force_full_materialize = t.force_full_materialize;
@@ -1230,6 +1319,55 @@ void TempTable::AddOrder(vcolumn::VirtualColumn *vc, int direction) {
   if (!already_added) order_by.push_back(d);
 }
 
+void TempTable::AddWindow(int attr, int kind, int64_t offset, int arg, const std::vector<int> &partition) {
+  windows.push_back(Window{kind, attr, arg, offset, partition});
+  if (arg >= 0) attrs[arg]->window_arg = true;
+  for (auto p : partition) attrs[p]->window_arg = true;
+
+  // the type of the result
+  common::CT type = common::CT::NUM;
+  uint scale = 0;
+  uint precision = 18;
+  bool notnull = true;
+  DTCollation collation;
+  switch (kind) {
+    case Item_func_sdb_window::ROW_NUMBER:
+    case Item_func_sdb_window::RANK:
+    case Item_func_sdb_window::RUNNING_COUNT:
+      break;
+    case Item_func_sdb_window::RUNNING_SUM:
+      notnull = false;
+      if (attrs[arg]->TypeName() == common::CT::BIGINT) {
+        type = common::CT::BIGINT;
+        precision = 19;
+      } else if (ATI::IsRealType(attrs[arg]->TypeName())) {
+        type = common::CT::REAL;
+      } else if (ATI::IsFixedNumericType(attrs[arg]->TypeName())) {
+        scale = attrs[arg]->Type().GetScale();
+      } else
+        throw common::NotImplementedException("SDB_RUNNING_SUM of a non-numerical column.");
+      break;
+    case Item_func_sdb_window::RUNNING_AVG:
+      if (!ATI::IsNumericType(attrs[arg]->TypeName()))
+        throw common::NotImplementedException("SDB_RUNNING_AVG of a non-numerical column.");
+      type = common::CT::REAL;
+      notnull = false;
+      break;
+    default:  // LAG, LEAD
+      type = attrs[arg]->TypeName();
+      scale = attrs[arg]->Type().GetScale();
+      precision = attrs[arg]->Type().GetPrecision();
+      collation = attrs[arg]->GetCollation();
+      notnull = false;
+      break;
+  }
+  Attr *old_attr = attrs[attr];
+  attrs[attr] = new Attr(old_attr->term, common::ColOperation::LISTING, p_power, false, old_attr->alias, -2, type,
+                         scale, precision, notnull, collation);
+  attrs[attr]->window = true;
+  delete old_attr;
+}
+
 void TempTable::Union(TempTable *t, int all) {
   MEASURE_FET("TempTable::UnionOld(...)");
   if (!t) {  // trivial union with single select and external order by
@@ -1733,6 +1871,8 @@ int TempTable::DimInDistinctContext() {
 bool TempTable::LimitMayBeAppliedToWhere() {
   if (order_by.size() > 0)  // ORDER BY => false
     return false;
+  if (!windows.empty())  // analytic functions need all rows
+    return false;
   if (mode.distinct || HasHavingConditions())  // DISTINCT or HAVING  => false
     return false;
   for (uint i = 0; i < NumOfAttrs(); i++)  // GROUP BY or other aggregation => false
@@ -1843,8 +1983,177 @@ bool TempTable::CanOrderSources() {
   return true;
 }
 
+namespace {
+bool SameValue(TempTable::Attr *a, int64_t row1, int64_t row2) {
+  bool null1 = a->IsNull(row1);
+  bool null2 = a->IsNull(row2);
+  if (null1 || null2) return null1 == null2;
+  if (ATI::IsStringType(a->TypeName())) {
+    types::BString s1, s2;
+    a->GetValueString(s1, row1);
+    a->GetValueString(s2, row2);
+    return types::CollationStrCmp(a->GetCollation(), s1, s2) == 0;
+  }
+  int64_t v1 = a->GetValueInt64(row1);
+  int64_t v2 = a->GetValueInt64(row2);
+  if (ATI::IsRealType(a->TypeName())) return *(double *)&v1 == *(double *)&v2;
+  return v1 == v2;
+}
+}  // namespace
+
+bool TempTable::SamePartition(const Window &w, int64_t row1, int64_t row2) {
+  for (auto p : w.partition)
+    if (!SameValue(attrs[p], row1, row2)) return false;
+  return true;
+}
+
+void TempTable::WindowTask(Transaction *ci, int64_t start, int64_t end) {
+  current_tx = ci;
+  for (auto &w : windows) {
+    Attr *res = attrs[w.attr];
+    Attr *v = (w.arg >= 0 ? attrs[w.arg] : NULL);
+    bool real_arg = v && ATI::IsRealType(v->TypeName());
+    bool string_arg = v && ATI::IsStringType(v->TypeName());
+    double scale = v ? types::PowOfTen(v->Type().GetScale()) : 1;
+    types::BString val_s;
+    int64_t part_end;
+    for (int64_t part_start = start; part_start < end; part_start = part_end) {
+      if (m_conn->Killed()) throw common::KilledException();
+      part_end = part_start + 1;
+      while (part_end < end && SamePartition(w, part_end - 1, part_end)) part_end++;
+
+      int64_t rank = 0, count = 0, sum = 0;
+      double sum_d = 0;
+      for (int64_t row = part_start; row < part_end; row++) {
+        switch (w.kind) {
+          case Item_func_sdb_window::ROW_NUMBER:
+            res->PutValueInt64(row, row - part_start + 1);
+            break;
+          case Item_func_sdb_window::RANK:
+            if (row == part_start || !SameValue(v, row - 1, row)) rank = row - part_start + 1;
+            res->PutValueInt64(row, rank);
+            break;
+          case Item_func_sdb_window::RUNNING_SUM:
+          case Item_func_sdb_window::RUNNING_COUNT:
+          case Item_func_sdb_window::RUNNING_AVG: {
+            if (!v->IsNull(row)) {
+              int64_t val = v->GetValueInt64(row);
+              count++;
+              if (real_arg)
+                sum_d += *(double *)&val;
+              else
+                sum += val;
+            }
+            if (w.kind == Item_func_sdb_window::RUNNING_COUNT) {
+              res->PutValueInt64(row, count);
+            } else if (count == 0) {
+              res->PutValueInt64(row, common::NULL_VALUE_64);
+            } else if (w.kind == Item_func_sdb_window::RUNNING_AVG) {
+              double avg = (real_arg ? sum_d : sum / scale) / count;
+              res->PutValueInt64(row, *(int64_t *)&avg);
+            } else if (real_arg) {
+              res->PutValueInt64(row, *(int64_t *)&sum_d);
+            } else
+              res->PutValueInt64(row, sum);
+            break;
+          }
+          default: {  // LAG, LEAD
+            int64_t src = (w.kind == Item_func_sdb_window::LAG ? row - w.offset : row + w.offset);
+            bool in_partition = (src >= part_start && src < part_end);
+            if (string_arg) {
+              if (in_partition)
+                v->GetValueString(val_s, src);
+              else
+                val_s = types::BString();
+              res->PutValueString(row, val_s);
+            } else
+              res->PutValueInt64(row, in_partition ? v->GetValueInt64(src) : common::NULL_VALUE_64);
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+void TempTable::ComputeWindows() {
+  MEASURE_FET("TempTable::ComputeWindows(...)");
+  for (auto &w : windows) attrs[w.attr]->CreateBuffer(no_obj, m_conn);
+  if (no_obj == 0) return;
+
+  // Partitions are independent, so the rows are split into ranges starting at
+  // partition boundaries, computed in parallel. Buffers written concurrently
+  // must be resident, i.e. fit in one page.
+  bool one_page = !rceng->query_thread_pool.is_owner();
+  for (auto &attr : attrs)
+    if ((attr->window || attr->window_arg) && attr->page_size < no_obj) one_page = false;
+  int64_t no_tasks = one_page ? std::min<int64_t>(rceng->query_thread_pool.size(), no_obj / 65536 + 1) : 1;
+
+  std::vector<int64_t> bounds{0};
+  for (int64_t t = 1; t < no_tasks; t++) {
+    int64_t row = std::max(bounds.back() + 1, no_obj * t / no_tasks);
+    // move to the start of a partition of every function
+    while (row < no_obj) {
+      bool boundary = true;
+      for (auto &w : windows)
+        if (SamePartition(w, row - 1, row)) boundary = false;
+      if (boundary) break;
+      row++;
+    }
+    if (row >= no_obj) break;
+    bounds.push_back(row);
+  }
+  bounds.push_back(no_obj);
+
+  if (bounds.size() == 2) {
+    WindowTask(current_tx, 0, no_obj);
+  } else {
+    utils::result_set<void> res;
+    for (size_t i = 0; i + 1 < bounds.size(); i++)
+      res.insert(rceng->query_thread_pool.add_task(&TempTable::WindowTask, this, current_tx, bounds[i], bounds[i + 1]));
+    res.get_all_with_except();
+  }
+  for (auto &w : windows) attrs[w.attr]->SetFilled(no_obj);
+}
+
+void TempTable::MaterializeWindows(bool in_subq) {
+  MEASURE_FET("TempTable::MaterializeWindows(...)");
+  if (mode.distinct) throw common::NotImplementedException("Analytic functions with DISTINCT.");
+  for (auto &attr : attrs)
+    if (attr->mode != common::ColOperation::LISTING)
+      throw common::NotImplementedException("Analytic functions with aggregations.");
+
+  // the functions see all rows in the final order, limits are applied to their result
+  bool limits_present = mode.top;
+  int64_t offset = (mode.param1 >= 0 ? mode.param1 : 0);
+  int64_t limit = (mode.param2 >= 0 ? mode.param2 : 0);
+  mode.top = false;
+  mode.param1 = 0;
+  mode.param2 = -1;
+  force_full_materialize = true;
+
+  std::vector<Window> pending;
+  pending.swap(windows);
+  Materialize(in_subq, NULL, false);
+  windows.swap(pending);
+  ComputeWindows();
+  // from now on the results are ordinary columns, e.g. for sorting a UNION
+  for (auto &attr : attrs) attr->window = attr->window_arg = false;
+
+  if (limits_present) {
+    int64_t local_offset = std::min(no_obj, offset);
+    ApplyOffset(std::max<int64_t>(std::min(limit, no_obj - local_offset), 0), local_offset);
+    output_mind.Clear();
+    output_mind.AddDimension_cross(no_obj);
+  }
+}
+
 void TempTable::Materialize(bool in_subq, ResultSender *sender, bool lazy) {
   MEASURE_FET("TempTable::Materialize()");
+  if (!windows.empty() && !materialized && !mode.exists) {
+    MaterializeWindows(in_subq);
+    return;
+  }
   if (sender) sender->SetAffectRows(no_obj);
   CreateDisplayableAttrP();
   CalculatePageSize();
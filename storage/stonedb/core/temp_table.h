@@ -71,6 +71,8 @@ class TempTable : public JustATable {
     uint orig_precision;
     bool not_complete;  // does not contain all the column elements - some
                         // functions cannot be computed
+    bool window = false;      // computed by an analytic function after materialization
+    bool window_arg = false;  // an argument of an analytic function
 
     Attr(CQTerm t, common::ColOperation m, uint32_t power, bool distinct = false, char *alias = NULL, int dim = -1,
          common::CT type = common::CT::INT, uint scale = 0, uint precision = 10, bool notnull = true,
@@ -82,10 +84,13 @@ class TempTable : public JustATable {
 
     bool ShouldOutput() const { return (mode == common::ColOperation::LISTING) && term.vc && alias; }
     bool NeedFill() const {
-      return ((mode == common::ColOperation::LISTING) && term.vc && alias) ||
+      if (window) return false;
+      return ((mode == common::ColOperation::LISTING) && term.vc && alias) || window_arg ||
              !term.vc->IsConst();  // constant value, the buffer is already
                                    // filled in
     }
+    // columns taken from the sorter by OrderByAndMaterialize()
+    bool FilledBySorting() const { return (alias != NULL && !window) || window_arg; }
 
     enum phys_col_t ColType() const override { return phys_col_t::ATTR; }
     //! Use in cases where actual string length is less than declared, before
@@ -99,6 +104,13 @@ class TempTable : public JustATable {
     void CreateBuffer(uint64_t size, Transaction *conn = NULL, bool not_completed = false);
     void FillValue(const MIIterator &mii, size_t idx);
     size_t FillValues(MIIterator &mii, size_t start, size_t count);
+    // Parallel filling: the rows [start, end) of one buffer page, made resident
+    // by LoadBufferPage() (false if they are not in one page), may be filled by
+    // several FillRange() calls at once, each with its own copy of term.vc.
+    // FillRange() does not count the rows, SetFilled() does it when all are done.
+    bool LoadBufferPage(int64_t start, int64_t end);
+    size_t FillRange(MIIterator &mii, size_t start, size_t count, vcolumn::VirtualColumn *vc);
+    void SetFilled(int64_t end);
     void SetNewPageSize(uint new_page_size);
     void SetValueString(int64_t obj, const types::BString &val);
     types::RCValueObject GetValue(int64_t obj, bool lookup_to_num = false) override;
@@ -135,6 +147,9 @@ class TempTable : public JustATable {
     int64_t GetValueInt64(int64_t obj) const override;
     int64_t GetNotNullValueInt64(int64_t obj) const override;
     void SetValueInt64(int64_t obj, int64_t val);
+    void PutValueInt64(int64_t obj, int64_t val);  // SetValueInt64() without counting the row
+    void PutValueString(int64_t obj, const types::BString &val);
+    void PutValue(vcolumn::VirtualColumn *vc, const MIIterator &mii, size_t idx);
     void InvalidateRow(int64_t obj);
     int64_t GetMinInt64(int pack) override;
     int64_t GetMaxInt64(int pack) override;
@@ -199,6 +214,7 @@ class TempTable : public JustATable {
  public:
   virtual ~TempTable();
   void TranslateBackVCs();
+  bool IsParametrized();  // is the temptable (select) parametrized?
   // Query execution (CompiledQuery language implementation)
   void AddConds(Condition *cond, CondType type);
   void AddInnerConds(Condition *cond, std::vector<TabID> &dims);
@@ -207,6 +223,9 @@ class TempTable : public JustATable {
   void JoinT(JustATable *t, int alias, JoinType jt);
   int AddColumn(CQTerm, common::ColOperation, char *alias, bool distinct, SI si);
   void AddOrder(vcolumn::VirtualColumn *vc, int direction);
+  // attr is computed by the analytic function 'kind'
+  // (Item_func_sdb_window::Window_kind) of the column arg (-1 if none)
+  void AddWindow(int attr, int kind, int64_t offset, int arg, const std::vector<int> &partition);
   void Union(TempTable *, int);
   void Union(TempTable *, int, ResultSender *sender, int64_t &g_offset, int64_t &g_limit);
   void RoughUnion(TempTable *, ResultSender *sender);
@@ -373,6 +392,9 @@ class TempTable : public JustATable {
   void MoveVC(vcolumn::VirtualColumn *vc, std::vector<vcolumn::VirtualColumn *> &from,
               std::vector<vcolumn::VirtualColumn *> &to);
   void FillbufferTask(Attr *attr, Transaction *ci, MIIterator *page_start, int64_t start_row, int64_t page_end);
+  void WindowTask(Transaction *ci, int64_t start, int64_t end);
+  void FillRangeTask(Attr *attr, Transaction *ci, MIIterator *range_start, int64_t start_row, int64_t count,
+                     char *redo);
   size_t TaskPutValueInST(MIIterator *it, Transaction *ci, SorterWrapper *st);
   bool HasTempTable() const { return has_temp_table; }
 
@@ -396,6 +418,15 @@ class TempTable : public JustATable {
   MultiIndex output_mind;                           // one dimensional MultiIndex used for operations on
                                                     // output columns of TempTable
   std::vector<SortDescriptor> order_by;             // indexes of order by columns
+  // analytic function computed on the rows of the materialized table
+  struct Window {
+    int kind;                    // Item_func_sdb_window::Window_kind
+    int attr;                    // output column
+    int arg;                     // argument column, -1 if none
+    int64_t offset;              // LAG/LEAD distance
+    std::vector<int> partition;  // partition columns
+  };
+  std::vector<Window> windows;
   bool group_by = false;                            // true if there is at least one grouping column
   bool is_vc_owner = true;                          // true if temptable should dealocate virtual columns
   int no_global_virt_cols;                          // keeps number of virtual columns. In case for_subq
@@ -406,11 +437,13 @@ class TempTable : public JustATable {
   // some internal functions for low-level query execution
   static const uint CACHE_SIZE = 100000000;  // size of memory cache for data in the materialized TempTable
   // everything else is cached on disk (CachedBuffer)
-  bool IsParametrized();  // is the temptable (select) parametrized?
   void SendResult(int64_t local_limit, int64_t local_offset, ResultSender &sender, bool pagewise);
 
   void ApplyOffset(int64_t limit,
                    int64_t offset);  // apply limit and offset to attr buffers
+  void MaterializeWindows(bool in_subq);
+  void ComputeWindows();
+  bool SamePartition(const Window &w, int64_t row1, int64_t row2);
 
   bool materialized = false;
   bool has_temp_table = false;
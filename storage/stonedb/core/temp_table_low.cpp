@@ -20,6 +20,9 @@
    execution low-level mechanisms
 */
 
+#include <algorithm>
+#include <numeric>
+
 #include "common/assert.h"
 #include "common/data_format.h"
 #include "core/engine.h"
@@ -39,6 +42,22 @@
 
 namespace stonedb {
 namespace core {
+namespace {
+// move 'it' forward by up to 'rows' rows, return the number of rows passed
+int64_t Advance(MIIterator &it, int64_t rows) {
+  int64_t n = 0;
+  while (it.IsValid() && it.GetPackSizeLeft() != common::NULL_VALUE_64 && n + it.GetPackSizeLeft() <= rows) {
+    n += it.GetPackSizeLeft();
+    it.NextPackrow();
+  }
+  while (it.IsValid() && n < rows) {
+    ++it;
+    ++n;
+  }
+  return n;
+}
+}  // namespace
+
 bool TempTable::OrderByAndMaterialize(std::vector<SortDescriptor> &ord, int64_t limit, int64_t offset,
                                       ResultSender *sender)  // Sort MultiIndex using some (existing) attributes
                                                              // in some tables
@@ -107,7 +126,7 @@ bool TempTable::OrderByAndMaterialize(std::vector<SortDescriptor> &ord, int64_t
 
   int sort_order = 0;
   for (auto &j : attrs) {
-    if (j->alias != NULL) {
+    if (j->FilledBySorting()) {
       vcolumn::VirtualColumn *vc = j->term.vc;
       DEBUG_ASSERT(vc);
       sort_order = 0;
@@ -226,7 +245,7 @@ bool TempTable::OrderByAndMaterialize(std::vector<SortDescriptor> &ord, int64_t
 
   // Create output
   for (uint i = 0; i < NumOfAttrs(); i++) {
-    if (attrs[i]->alias != NULL) {
+    if (attrs[i]->FilledBySorting()) {
       if (sender)
         attrs[i]->CreateBuffer(no_obj > stonedb_sysvar_result_sender_rows ? stonedb_sysvar_result_sender_rows : no_obj,
                                m_conn, no_obj > stonedb_sysvar_result_sender_rows);
@@ -237,12 +256,58 @@ bool TempTable::OrderByAndMaterialize(std::vector<SortDescriptor> &ord, int64_t
 
   int64_t global_row = 0;
   local_row = 0;
-  types::BString val_s;
-  int64_t val64;
   int64_t offset_done = 0;
   int64_t produced_rows = 0;
-  bool null_value;
   bool valid = true;
+
+  // copy a value of the sorter column 'col' to 'row' of 'attr'; implicit columns are read at position 'pos'
+  auto put_value = [&sorted_table](Attr *attr, int64_t row, int col, const MIDummyIterator *pos) {
+    switch (attr->TypeName()) {
+      case common::CT::STRING:
+      case common::CT::VARCHAR:
+      case common::CT::BIN:
+      case common::CT::BYTE:
+      case common::CT::VARBYTE:
+      case common::CT::LONGTEXT:
+        attr->SetValueString(row, pos ? sorted_table.GetValueT(col, *pos) : sorted_table.GetValueT(col));
+        break;
+      default: {
+        bool null_value;
+        int64_t val64 = (pos ? sorted_table.GetValue64(col, *pos, null_value)
+                             : sorted_table.GetValue64(col, null_value));  // works also for constants
+        attr->SetValueInt64(row, null_value ? common::NULL_VALUE_64 : val64);
+        break;
+      }
+    }
+  };
+
+  // Late materialization: implicit columns are read only for the rows which
+  // survived sorting and limit, in the order of their positions so that every
+  // pack is loaded once rather than visited in the sorted order.
+  int mind_dims = filter.mind->NumOfDimensions();
+  std::vector<int64_t> late_pos;  // positions of the buffered rows, 'mind_dims' values each
+  auto fill_late_columns = [&](int64_t no_rows) {
+    std::vector<int64_t> order(no_rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&late_pos, mind_dims](int64_t a, int64_t b) {
+      return std::lexicographical_compare(late_pos.begin() + a * mind_dims, late_pos.begin() + (a + 1) * mind_dims,
+                                          late_pos.begin() + b * mind_dims, late_pos.begin() + (b + 1) * mind_dims);
+    });
+    MIDummyIterator pos(filter.mind);
+    for (auto row : order) {
+      if (m_conn->Killed()) throw common::KilledException();
+      for (int dim = 0; dim < mind_dims; dim++) pos.Set(dim, late_pos[row * mind_dims + dim]);
+      int col = 0;
+      for (auto &attr : attrs) {
+        if (attr->FilledBySorting()) {
+          if (sorted_table.IsImplicit(col)) put_value(attr, row, col, &pos);
+          col++;
+        }
+      }
+    }
+    late_pos.clear();
+  };
+
   do {  // outer loop - through streaming buffers (if sender != NULL)
     do {
       valid = sorted_table.FetchNextRow();
@@ -250,28 +315,15 @@ bool TempTable::OrderByAndMaterialize(std::vector<SortDescriptor> &ord, int64_t
         int col = 0;
         if (m_conn->Killed()) throw common::KilledException();
         for (auto &attr : attrs) {
-          if (attr->alias != NULL) {
-            switch (attr->TypeName()) {
-              case common::CT::STRING:
-              case common::CT::VARCHAR:
-              case common::CT::BIN:
-              case common::CT::BYTE:
-              case common::CT::VARBYTE:
-              case common::CT::LONGTEXT:
-                val_s = sorted_table.GetValueT(col);
-                attr->SetValueString(local_row, val_s);
-                break;
-              default:
-                val64 = sorted_table.GetValue64(col, null_value);  // works also for constants
-                if (null_value)
-                  attr->SetValueInt64(local_row, common::NULL_VALUE_64);
-                else
-                  attr->SetValueInt64(local_row, val64);
-                break;
-            }
+          if (attr->FilledBySorting()) {
+            if (!sorted_table.IsImplicit(col)) put_value(attr, local_row, col, NULL);
             col++;
           }
         }
+        if (sorted_table.HasImplicitColumns()) {
+          const MIDummyIterator &cur_pos = sorted_table.GetCurrentPosition();
+          for (int dim = 0; dim < mind_dims; dim++) late_pos.push_back(cur_pos[dim]);
+        }
         local_row++;
         ++produced_rows;
         if ((global_row - offset + 1) % 10000000 == 0)
@@ -284,6 +336,7 @@ bool TempTable::OrderByAndMaterialize(std::vector<SortDescriptor> &ord, int64_t
     } while (valid && global_row < limit + offset &&
              !(sender && local_row >= stonedb_sysvar_result_sender_rows));  // a limit for
                                                                             // streaming buffer
+    if (sorted_table.HasImplicitColumns()) fill_late_columns(local_row);
     // Note: what about SetNumOfMaterialized()? Only no_obj is set now.
     if (sender) {
       TempTable::RecordIterator iter = begin();
@@ -368,8 +421,10 @@ void TempTable::FillMaterializedBuffers(int64_t local_limit, int64_t local_offse
   // row		- a row number in orig. tables
   // no_obj	- a number of rows to be actually sent (offset already omitted)
   // start_row, page_end - in terms of orig. tables
+  // a page is filled in ranges of a packrow
+  const int64_t range_size = int64_t(1) << filter.mind->ValueOfPower();
+  std::vector<char> filled_by_ranges(attrs.size(), 0);
   while (it.IsValid() && row < no_obj + local_offset) { /* go thru all rows */
-    bool outer_iterator_updated = false;
     MIIterator page_start(it);
     int64_t start_row = row;
     int64_t page_end = (((row - local_offset) / page_size) + 1) * page_size + local_offset;
@@ -379,27 +434,53 @@ void TempTable::FillMaterializedBuffers(int64_t local_limit, int64_t local_offse
 
     for (uint i = 0; i < NumOfAttrs(); i++) attrs[i]->CreateBuffer(page_end - start_row, m_conn, pagewise);
 
-    auto &attr = attrs[0];
-    if (attr->NeedFill()) {
-      MIIterator i(page_start);
-      auto cnt = attr->FillValues(i, start_row, page_end - start_row);
-      no_materialized += cnt;
-      if (!outer_iterator_updated) {
-        it.swap(i); /* update global iterator - once */
-        row = start_row + cnt;
-        outer_iterator_updated = true;
-      }
+    // split the page into ranges of a packrow size; 'it' ends after the page
+    std::vector<MIIterator> ranges;
+    int64_t cnt = 0;
+    while (it.IsValid() && cnt < page_end - start_row) {
+      ranges.push_back(it);
+      cnt += Advance(it, std::min(range_size, page_end - start_row - cnt));
     }
+    row = start_row + cnt;
+    no_materialized += cnt;
+
+    // columns which can be copied are filled by ranges in parallel, others by
+    // one task for the whole page; an expression column is not thread safe, but
+    // its copies are as long as they are computed by a native kernel only
     utils::result_set<void> res;
-    for (uint i = 1; i < attrs.size(); i++) {
-      if (!skip_parafilloutput[i]) {
+    std::vector<std::vector<char>> redo(attrs.size());  // ranges a native kernel could not fill
+    for (uint i = 0; i < attrs.size(); i++) {
+      if (skip_parafilloutput[i] || !attrs[i]->NeedFill()) continue;
+      auto vc = attrs[i]->term.vc;
+      auto ec = dynamic_cast<vcolumn::ExpressionColumn *>(vc);
+      if (ranges.size() > 1 && vc->CanCopy() && (vc->IsThreadSafe() || (ec && ec->HasNativeKernel())) &&
+          attrs[i]->LoadBufferPage(start_row, start_row + cnt)) {
+        redo[i].assign(ranges.size(), 0);
+        for (size_t r = 0; r < ranges.size(); r++)
+          res.insert(rceng->query_thread_pool.add_task(&TempTable::FillRangeTask, this, attrs[i], current_tx,
+                                                       &ranges[r], start_row + int64_t(r) * range_size,
+                                                       std::min(range_size, cnt - int64_t(r) * range_size),
+                                                       &redo[i][r]));
+        filled_by_ranges[i] = 1;
+      } else {
         res.insert(rceng->query_thread_pool.add_task(&TempTable::FillbufferTask, this, attrs[i], current_tx,
                                                      &page_start, start_row, page_end));
       }
     }
     res.get_all_with_except();
+    for (uint i = 0; i < attrs.size(); i++)
+      if (filled_by_ranges[i]) {
+        for (size_t r = 0; r < redo[i].size(); r++)
+          if (redo[i][r]) {
+            MIIterator range_it(ranges[r]);
+            attrs[i]->FillRange(range_it, start_row + int64_t(r) * range_size,
+                                std::min(range_size, cnt - int64_t(r) * range_size), attrs[i]->term.vc);
+          }
+        attrs[i]->SetFilled(start_row + cnt);
+        filled_by_ranges[i] = 0;
+      }
 
-    for (uint i = 1; i < attrs.size(); i++)
+    for (uint i = 0; i < attrs.size(); i++)
       if (skip_parafilloutput[i]) FillbufferTask(attrs[i], current_tx, &page_start, start_row, page_end);
 
     if (lazy) break;
@@ -541,6 +622,19 @@ void TempTable::FillbufferTask(Attr *attr, Transaction *ci, MIIterator *page_sta
   }
 }
 
+void TempTable::FillRangeTask(Attr *attr, Transaction *ci, MIIterator *range_start, int64_t start_row,
+                              int64_t count, char *redo) {
+  common::SetMySQLTHD(m_conn->Thd());
+  current_tx = ci;
+  std::unique_ptr<vcolumn::VirtualColumn> vc(CreateVCCopy(attr->term.vc));
+  // the item tree is shared with the original column, so a copy must not use it
+  auto ec = dynamic_cast<vcolumn::ExpressionColumn *>(vc.get());
+  if (ec) ec->SetNativeOnly();
+  MIIterator i(*range_start);
+  attr->FillRange(i, start_row, count, vc.get());
+  if (ec && ec->NativeFailed()) *redo = 1;
+}
+
 size_t TempTable::TaskPutValueInST(MIIterator *it, Transaction *ci, SorterWrapper *st) {
   size_t local_row = 0;
   bool continue_now = true;
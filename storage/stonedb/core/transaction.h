@@ -43,6 +43,7 @@ class Transaction final {
   int session_trace = 0;
   int debug_level = 0;
   std::string explain_msg;
+  std::string fallback_reason;  // why the current query goes to MySQL, if it does
   index::KVTransaction kv_trans;
 
  public:
@@ -60,6 +61,13 @@ class Transaction final {
   bool Explain() { return (thd ? thd->lex->describe : false); }
   std::string GetExplainMsg() { return explain_msg; }
   void SetExplainMsg(const std::string &msg) { explain_msg = msg; }
+  // the first reason set is kept: it comes from the innermost failing check,
+  // the callers only propagate the failure
+  void SetFallbackReason(const std::string &reason) {
+    if (fallback_reason.empty()) fallback_reason = reason;
+  }
+  const std::string &GetFallbackReason() const { return fallback_reason; }
+  void ResetFallbackReason() { fallback_reason.clear(); }
   bool m_explicit_lock_tables = false;
 
   Transaction(THD *thd) : tid(sg.NextID()), thd(thd) {}
@@ -48,6 +48,7 @@ class ValueMatching_HashTable : public mm::TraceableObject, public ValueMatching
   int64_t GetCurrentRow() override { return t.GetCurrent(); }
   void NextRow() override { t.NextRow(); }
   bool RowValid() override { return (t.GetCurrent() != -1); }
+  int64_t GetRowAt(int64_t n) override { return n; }  // rows are numbered densely
   bool SetCurrentRow(int64_t row) override { return t.SetCurrentRow(row); }
   bool SetEndRow(int64_t row) override { return t.SetEndRow(row); }
   bool NoMoreSpace() override { return int64_t(no_rows) >= max_no_rows; }
@@ -73,6 +73,8 @@ class ValueMatchingTable {  // abstract class: interface for value matching
   virtual bool RowValid() = 0;                    // false if there is no more rows to iterate
   virtual bool SetCurrentRow([[maybe_unused]] int64_t row) { return true; }
   virtual bool SetEndRow([[maybe_unused]] int64_t row) { return true; }
+  virtual int64_t GetRowAt(int64_t n) = 0;        // number of the n-th stored row (n < NoRows()), the
+                                                  // iterator is not used, so it may be called concurrently
   /*
           Selection algorithm and initialization of the created object. Input
      values:
@@ -116,6 +118,7 @@ class ValueMatching_OnePosition : public ValueMatchingTable {
   int64_t GetCurrentRow() override { return 0; }
   void NextRow() override { iterator_valid = false; }
   bool RowValid() override { return iterator_valid; }
+  int64_t GetRowAt([[maybe_unused]] int64_t n) override { return 0; }
   bool NoMoreSpace() override { return no_rows > 0; }
   int MemoryBlocksLeft() override { return 999; }  // one-pass only
   bool IsOnePass() override { return true; }
@@ -157,6 +160,7 @@ class ValueMatching_LookupTable : public mm::TraceableObject, public ValueMatchi
   int64_t GetCurrentRow() override { return occupied_table[occupied_iterator]; }
   void NextRow() override { occupied_iterator++; }
   bool RowValid() override { return (occupied_iterator < no_rows); }
+  int64_t GetRowAt(int64_t n) override { return occupied_table[n]; }
   bool SetCurrentRow(int64_t row) override;
   bool SetEndRow(int64_t row) override;
   bool NoMoreSpace() override { return no_rows >= max_no_rows; }
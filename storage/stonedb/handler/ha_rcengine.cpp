@@ -18,6 +18,7 @@
 #include "common/mysql_gate.h"
 #include "core/compilation_tools.h"
 #include "core/engine.h"
+#include "core/transaction.h"
 #include "system/configuration.h"
 #include "util/log_ctl.h"
 #include "vc/virtual_column.h"
@@ -49,7 +50,9 @@ bool AtLeastOneSDBTableInvolved(LEX *lex) {
   return FALSE;
 }
 
-bool ForbiddenMySQLQueryPath([[maybe_unused]] LEX *lex) { return (stonedb_sysvar_allowmysqlquerypath == 0); }
+bool ForbiddenMySQLQueryPath([[maybe_unused]] LEX *lex) {
+  return (stonedb_sysvar_allowmysqlquerypath == 0 || stonedb_sysvar_fallback_error);
+}
 }  // namespace
 
 bool SDB_SetStatementAllowed(THD *thd, LEX *lex) {
@@ -82,9 +85,13 @@ int SDB_HandleSelect(THD *thd, LEX *lex, Query_result *&result, ulong setup_tabl
                                                 sdb_free_join, with_insert);
     if (handle_select_ret == RETURN_QUERY_TO_MYSQL_ROUTE && AtLeastOneSDBTableInvolved(lex) &&
         ForbiddenMySQLQueryPath(lex)) {
+      std::string reason = current_tx ? current_tx->GetFallbackReason() : "";
       my_message(static_cast<int>(common::ErrorCode::UNKNOWN_ERROR),
-                 "The query includes syntax that is not supported by the storage engine. \
-Either restructure the query with supported syntax, or enable the MySQL core::Query Path in config file to execute the query with reduced performance.",
+                 ("The query includes syntax that is not supported by the storage engine" +
+                  (reason.empty() ? std::string() : " (" + reason + ")") +
+                  ". Either restructure the query with supported syntax, or enable the MySQL core::Query Path in "
+                  "config file to execute the query with reduced performance.")
+                     .c_str(),
                  MYF(0));
       handle_select_ret = RCBASE_QUERY_ROUTE;
     }
@@ -1215,6 +1215,34 @@ int StonedbHandler::truncate() {
   return ret;
 }
 
+// Rebuild the rough indexes (histogram, cmap, bloom and multi-column indexes)
+// from the data packs. The new versions become visible at commit.
+int StonedbHandler::optimize(THD *thd, [[maybe_unused]] HA_CHECK_OPT *check_opt) {
+  DBUG_ENTER(__PRETTY_FUNCTION__);
+  if (!stonedb_sysvar_enable_histogram_cmap_bloom) {
+    common::PushWarning(thd, Sql_condition::SL_WARNING, ER_UNKNOWN_ERROR,
+                        "Rough indexes are not rebuilt while stonedb_enable_histogram_cmap_bloom is off");
+    DBUG_RETURN(HA_ADMIN_OK);
+  }
+
+  try {
+    if (!rceng->RebuildRoughIndexes(m_table_name, table, thd))
+      common::PushWarning(thd, Sql_condition::SL_NOTE, ER_UNKNOWN_ERROR,
+                          "Rough index rebuild is not finished, run OPTIMIZE TABLE again to continue");
+    DBUG_RETURN(HA_ADMIN_OK);
+  } catch (common::KilledException &) {
+    STONEDB_LOG(LogCtl_Level::INFO, "Rough index rebuild of %s was killed", m_table_name.c_str());
+  } catch (std::exception &e) {
+    my_message(static_cast<int>(common::ErrorCode::UNKNOWN_ERROR), e.what(), MYF(0));
+    STONEDB_LOG(LogCtl_Level::ERROR, "An exception is caught: %s", e.what());
+  } catch (...) {
+    my_message(static_cast<int>(common::ErrorCode::UNKNOWN_ERROR), "An unknown system exception error caught.", MYF(0));
+    STONEDB_LOG(LogCtl_Level::ERROR, "An unknown system exception error caught.");
+  }
+
+  DBUG_RETURN(HA_ADMIN_FAILED);
+}
+
 int StonedbHandler::fill_row(uchar *buf) {
   if (table_new_iter == table_new_iter_end) return HA_ERR_END_OF_FILE;
 
@@ -132,6 +132,7 @@ class StonedbHandler final : public handler {
   int create(const char *name, TABLE *form,
              HA_CREATE_INFO *create_info) override;  // required
   int truncate() override;
+  int optimize(THD *thd, HA_CHECK_OPT *check_opt) override;
 
   enum_alter_inplace_result check_if_supported_inplace_alter(TABLE *altered_table,
                                                              Alter_inplace_info *ha_alter_info) override;
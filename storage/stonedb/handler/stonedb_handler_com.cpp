@@ -19,6 +19,8 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include "core/cached_buffer.h"
+#include "core/fallback_stat.h"
 #include "core/transaction.h"
 #include "handler/stonedb_handler.h"
 #include "mm/initializer.h"
@@ -367,6 +369,56 @@ int get_UpdatePerMinute_StatusVar([[maybe_unused]] MYSQL_THD thd, SHOW_VAR *outv
   return 0;
 }
 
+int get_SpillPages_StatusVar([[maybe_unused]] MYSQL_THD thd, SHOW_VAR *outvar, char *tmp) {
+  *((int64_t *)tmp) = core::SpillStat::pages;
+  outvar->value = tmp;
+  outvar->type = SHOW_LONGLONG;
+  return 0;
+}
+
+int get_SpillRawBytes_StatusVar([[maybe_unused]] MYSQL_THD thd, SHOW_VAR *outvar, char *tmp) {
+  *((int64_t *)tmp) = core::SpillStat::raw_bytes;
+  outvar->value = tmp;
+  outvar->type = SHOW_LONGLONG;
+  return 0;
+}
+
+int get_SpillWrittenBytes_StatusVar([[maybe_unused]] MYSQL_THD thd, SHOW_VAR *outvar, char *tmp) {
+  *((int64_t *)tmp) = core::SpillStat::written_bytes;
+  outvar->value = tmp;
+  outvar->type = SHOW_LONGLONG;
+  return 0;
+}
+
+int get_FallbackQueries_StatusVar([[maybe_unused]] MYSQL_THD thd, SHOW_VAR *outvar, char *tmp) {
+  *((int64_t *)tmp) = core::FallbackStat::Total();
+  outvar->value = tmp;
+  outvar->type = SHOW_LONGLONG;
+  return 0;
+}
+
+int get_JoinCacheHits_StatusVar([[maybe_unused]] MYSQL_THD thd, SHOW_VAR *outvar, char *tmp) {
+  *((int64_t *)tmp) = rceng->join_hash_cache.Hits();
+  outvar->value = tmp;
+  outvar->type = SHOW_LONGLONG;
+  return 0;
+}
+
+int get_JoinCacheMisses_StatusVar([[maybe_unused]] MYSQL_THD thd, SHOW_VAR *outvar, char *tmp) {
+  *((int64_t *)tmp) = rceng->join_hash_cache.Misses();
+  outvar->value = tmp;
+  outvar->type = SHOW_LONGLONG;
+  return 0;
+}
+
+int get_FallbackReasons_StatusVar([[maybe_unused]] MYSQL_THD thd, SHOW_VAR *var, char *buff) {
+  var->type = SHOW_CHAR;
+  var->value = buff;
+  std::string str = core::FallbackStat::Report().substr(0, SHOW_VAR_FUNC_BUFF_SIZE - 1);
+  std::memcpy(buff, str.c_str(), str.length() + 1);
+  return 0;
+}
+
 char masteslave_info[8192];
 
 SHOW_VAR stonedb_masterslave_dump[] = {{"info", masteslave_info, SHOW_CHAR, SHOW_SCOPE_UNDEF}, {NullS, NullS, SHOW_LONG, SHOW_SCOPE_UNDEF}};
@@ -407,6 +459,7 @@ void trace_update(MYSQL_THD thd, struct st_mysql_sys_var *var, void *var_ptr, co
 void controlquerylog_update(MYSQL_THD thd, struct st_mysql_sys_var *var, void *var_ptr, const void *save);
 void start_async_update(MYSQL_THD thd, struct st_mysql_sys_var *var, void *var_ptr, const void *save);
 extern void async_join_update(MYSQL_THD thd, struct st_mysql_sys_var *var, void *var_ptr, const void *save);
+void join_cache_size_update(MYSQL_THD thd, struct st_mysql_sys_var *var, void *var_ptr, const void *save);
 
 #define STATUS_FUNCTION(name, showtype, member)                                                             \
   int get_##name##_StatusVar([[maybe_unused]] MYSQL_THD thd, struct st_mysql_show_var *outvar, char *tmp) { \
@@ -503,6 +556,13 @@ static struct st_mysql_show_var statusvars[] = {
     STATUS_MEMBER(LoadDupTotal, load_dup_total),
     STATUS_MEMBER(UpdatePerMinute, update_per_minute),
     STATUS_MEMBER(UpdateTotal, update_total),
+    STATUS_MEMBER(SpillPages, spill_pages),
+    STATUS_MEMBER(SpillRawBytes, spill_raw_bytes),
+    STATUS_MEMBER(SpillWrittenBytes, spill_written_bytes),
+    STATUS_MEMBER(FallbackQueries, fallback_queries),
+    STATUS_MEMBER(FallbackReasons, fallback_reasons),
+    STATUS_MEMBER(JoinCacheHits, join_cache_hits),
+    STATUS_MEMBER(JoinCacheMisses, join_cache_misses),
     {0, 0, SHOW_UNDEF, SHOW_SCOPE_UNDEF},
 };
 
@@ -618,6 +678,41 @@ static MYSQL_SYSVAR_UINT(result_sender_rows, stonedb_sysvar_result_sender_rows,
                          "queries like select xxx from yyya",
                          NULL, NULL, 65536, 1024, 131072, 0);
 
+static MYSQL_SYSVAR_BOOL(spill_compression, stonedb_sysvar_spill_compression, PLUGIN_VAR_BOOL,
+                         "Compress pages of intermediate results written to the disk cache", NULL, NULL, TRUE);
+
+static MYSQL_SYSVAR_STR(rebuild_filters_columns, stonedb_sysvar_rebuild_filters_columns,
+                        PLUGIN_VAR_STR | PLUGIN_VAR_MEMALLOC,
+                        "Comma separated columns whose rough indexes OPTIMIZE TABLE rebuilds, empty for all columns",
+                        NULL, NULL, "");
+static MYSQL_SYSVAR_UINT(rebuild_filters_packs, stonedb_sysvar_rebuild_filters_packs, PLUGIN_VAR_UNSIGNED,
+                         "The maximum number of packs OPTIMIZE TABLE rebuilds in one statement, 0 for no limit", NULL,
+                         NULL, 0, 0, UINT_MAX, 0);
+static MYSQL_SYSVAR_UINT(rebuild_filters_threads, stonedb_sysvar_rebuild_filters_threads, PLUGIN_VAR_UNSIGNED,
+                         "The number of packs OPTIMIZE TABLE rebuilds concurrently", NULL, NULL, 4, 1, 1024, 0);
+static MYSQL_SYSVAR_UINT(union_threads, stonedb_sysvar_union_threads, PLUGIN_VAR_READONLY,
+                         "The number of UNION branches materialized concurrently, 0 to materialize them one by one",
+                         NULL, NULL, 4, 0, 100, 0);
+static MYSQL_SYSVAR_UINT(index_join_max_rows, stonedb_sysvar_index_join_max_rows, PLUGIN_VAR_UNSIGNED,
+                         "The maximum number of rows joined with a table by looking them up in its primary key index, "
+                         "0 to never use the index for joins",
+                         NULL, NULL, 100000, 0, UINT_MAX, 0);
+static MYSQL_SYSVAR_BOOL(fallback_error, stonedb_sysvar_fallback_error, PLUGIN_VAR_BOOL,
+                         "Fail queries on StoneDB tables that would be executed by MySQL instead of StoneDB", NULL,
+                         NULL, FALSE);
+static MYSQL_SYSVAR_UINT(join_cache_size, stonedb_sysvar_join_cache_size, PLUGIN_VAR_UNSIGNED,
+                         "Memory (MB) for join hash tables shared by queries joining the same filtered dimension, "
+                         "0 to disable",
+                         NULL, join_cache_size_update, 0, 0, UINT_MAX, 0);
+static MYSQL_SYSVAR_UINT(lookup_advice, stonedb_sysvar_lookup_advice, PLUGIN_VAR_UNSIGNED,
+                         "The first load into an empty table reports string columns with at most this many distinct "
+                         "values in the first pack row as LOOKUP candidates, 0 to disable",
+                         NULL, NULL, 0, 0, 65536, 0);
+static MYSQL_SYSVAR_UINT(groupby_parts_min_groups, stonedb_sysvar_groupby_parts_min_groups, PLUGIN_VAR_UNSIGNED,
+                         "Parallel GROUP BY merges the results of its threads by hash partitions if they found at "
+                         "least this many groups",
+                         NULL, NULL, 1 << 20, 1, UINT_MAX, 0);
+
 void debug_update(MYSQL_THD thd, [[maybe_unused]] struct st_mysql_sys_var *var, void *var_ptr, const void *save) {
   if (rceng) {
     auto cur_conn = rceng->GetTx(thd);
@@ -681,6 +776,12 @@ void async_join_update([[maybe_unused]] MYSQL_THD thd, [[maybe_unused]] struct s
   resolve_async_join_settings(settings);
 }
 
+void join_cache_size_update([[maybe_unused]] MYSQL_THD thd, [[maybe_unused]] struct st_mysql_sys_var *var,
+                            void *var_ptr, const void *save) {
+  *((unsigned int *)var_ptr) = *((unsigned int *)save);
+  if (rceng) rceng->join_hash_cache.Shrink();
+}
+
 static struct st_mysql_sys_var *sdb_showvars[] = {MYSQL_SYSVAR(bg_load_threads),
                                                   MYSQL_SYSVAR(cachinglevel),
                                                   MYSQL_SYSVAR(compensation_start),
@@ -738,6 +839,16 @@ static struct st_mysql_sys_var *sdb_showvars[] = {MYSQL_SYSVAR(bg_load_threads),
                                                   MYSQL_SYSVAR(force_hashjoin),
                                                   MYSQL_SYSVAR(start_async),
                                                   MYSQL_SYSVAR(result_sender_rows),
+                                                  MYSQL_SYSVAR(spill_compression),
+                                                  MYSQL_SYSVAR(rebuild_filters_columns),
+                                                  MYSQL_SYSVAR(rebuild_filters_packs),
+                                                  MYSQL_SYSVAR(rebuild_filters_threads),
+                                                  MYSQL_SYSVAR(union_threads),
+                                                  MYSQL_SYSVAR(index_join_max_rows),
+                                                  MYSQL_SYSVAR(fallback_error),
+                                                  MYSQL_SYSVAR(join_cache_size),
+                                                  MYSQL_SYSVAR(lookup_advice),
+                                                  MYSQL_SYSVAR(groupby_parts_min_groups),
                                                   NULL};
 }  // namespace dbhandler
 }  // namespace stonedb
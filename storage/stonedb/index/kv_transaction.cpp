@@ -35,6 +35,15 @@ rocksdb::Status KVTransaction::Get(rocksdb::ColumnFamilyHandle *column_family, c
   return m_index_batch->GetFromBatchAndDB(kvstore->GetRdb(), m_read_opts, column_family, key, value);
 }
 
+void KVTransaction::MultiGet(rocksdb::ColumnFamilyHandle *column_family, std::vector<rocksdb::Slice> &keys,
+                             std::vector<rocksdb::PinnableSlice> &values, std::vector<rocksdb::Status> &statuses) {
+  m_read_opts.total_order_seek = false;
+  values.resize(keys.size());
+  statuses.resize(keys.size());
+  m_index_batch->MultiGetFromBatchAndDB(kvstore->GetRdb(), m_read_opts, column_family, keys.size(), keys.data(),
+                                        values.data(), statuses.data(), false);
+}
+
 rocksdb::Status KVTransaction::Put(rocksdb::ColumnFamilyHandle *column_family, const rocksdb::Slice &key,
                                    const rocksdb::Slice &value) {
   m_index_batch->Put(column_family, key, value);
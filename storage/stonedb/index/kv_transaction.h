@@ -41,6 +41,9 @@ class KVTransaction {
         keyiter(std::make_shared<KeyIterator>(this)) {}
   ~KVTransaction();
   rocksdb::Status Get(rocksdb::ColumnFamilyHandle *column_family, const rocksdb::Slice &key, std::string *value);
+  // batched Get(), statuses[i] and values[i] belong to keys[i]
+  void MultiGet(rocksdb::ColumnFamilyHandle *column_family, std::vector<rocksdb::Slice> &keys,
+                std::vector<rocksdb::PinnableSlice> &values, std::vector<rocksdb::Status> &statuses);
   rocksdb::Status Put(rocksdb::ColumnFamilyHandle *column_family, const rocksdb::Slice &key,
                       const rocksdb::Slice &value);
   rocksdb::Status Delete(rocksdb::ColumnFamilyHandle *column_family, const rocksdb::Slice &key);
@@ -298,6 +298,43 @@ common::ErrorCode RCTableIndex::GetRowByKey(core::Transaction *tx, std::vector<s
   return common::ErrorCode::SUCCESS;
 }
 
+common::ErrorCode RCTableIndex::GetRowsByKeys(core::Transaction *tx, std::vector<std::string_view> &keys,
+                                              std::vector<int64_t> &rows) {
+  std::vector<std::string> packkeys;
+  std::vector<rocksdb::Slice> slices;
+  packkeys.reserve(keys.size());
+  slices.reserve(keys.size());
+  for (auto &key : keys) {
+    StringWriter packkey, info;
+    std::vector<std::string_view> fields{key};
+    m_rdbkey->pack_key(packkey, fields, info);
+    packkeys.emplace_back((const char *)packkey.ptr(), packkey.length());
+    slices.emplace_back(packkeys.back());
+  }
+
+  std::vector<rocksdb::PinnableSlice> values;
+  std::vector<rocksdb::Status> statuses;
+  tx->KVTrans().MultiGet(m_rdbkey->get_cf(), slices, values, statuses);
+
+  rows.assign(keys.size(), common::NULL_VALUE_64);
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (statuses[i].IsNotFound()) continue;
+    if (!statuses[i].ok()) return common::ErrorCode::FAILED;
+
+    StringReader reader({values[i].data(), values[i].size()});
+    // ver compatible
+    if (m_rdbkey->m_index_ver > static_cast<uint16_t>(enumIndexInfo::INDEX_INFO_VERSION_INITIAL)) {
+      uint16_t packlen;
+      reader.read_uint16(&packlen);
+      reader.read(packlen);
+    }
+    uint64_t row;
+    reader.read_uint64(&row);
+    rows[i] = row;
+  }
+  return common::ErrorCode::SUCCESS;
+}
+
 void KeyIterator::ScanToKey(std::shared_ptr<RCTableIndex> tab, std::vector<std::string_view> &fields,
                             common::Operator op) {
   if (!tab || !trans) {
@@ -53,6 +53,9 @@ class RCTableIndex final {
   common::ErrorCode InsertIndex(core::Transaction *tx, std::vector<std::string_view> &fields, uint64_t row);
   common::ErrorCode UpdateIndex(core::Transaction *tx, std::string_view &nkey, std::string_view &okey, uint64_t row);
   common::ErrorCode GetRowByKey(core::Transaction *tx, std::vector<std::string_view> &fields, uint64_t &row);
+  // look up one-column keys in a batch; rows[i] is common::NULL_VALUE_64 if keys[i] is not found
+  common::ErrorCode GetRowsByKeys(core::Transaction *tx, std::vector<std::string_view> &keys,
+                                  std::vector<int64_t> &rows);
 
  private:
   common::ErrorCode CheckUniqueness(core::Transaction *tx, const rocksdb::Slice &pk_slice);
@@ -49,10 +49,13 @@ ParsingStrategy::ParsingStrategy(const system::IOParameters &iop, std::vector<uc
       escape_char(iop.EscapeCharacter()),
       temp_buf(65536) {
   cs_info = get_charset(iop.CharsetInfoNumber(), 0);
+  parsers.resize(atis.size());
   for (ushort i = 0; i < atis.size(); ++i) {
     if (core::ATI::IsStringType(GetATI(i).Type())) {
       GetATI(i).SetCollation(get_charset(columns_collations[i], 0));
     }
+    if (core::ATI::IsNumericType(GetATI(i).Type()) || core::ATI::IsDateTimeType(GetATI(i).Type()))
+      parsers[i] = types::ValueParserForText::GetParsingFuntion(GetATI(i));
   }
 
   PrepareKMP(kmp_next_delimiter, delimiter);
@@ -447,13 +450,15 @@ void ParsingStrategy::GetValue(const char *value_ptr, size_t value_size, ushort
     buffer.ExpectedSize(new_size);
 
   } else {
-    types::BString tmp_string(value_ptr, value_size);
-    // reaching here, the parsing function should not be null
-    auto function = types::ValueParserForText::GetParsingFuntion(ati);
-    if (function(tmp_string, *reinterpret_cast<int64_t *>(buffer.Prepare(sizeof(int64_t)))) ==
-        common::ErrorCode::FAILED)
-      throw common::FormatException(0,
-                                    col);  // TODO: throw appropriate exception
+    int64_t *out = reinterpret_cast<int64_t *>(buffer.Prepare(sizeof(int64_t)));
+    if (!types::ValueParserForText::ParseFast(value_ptr, value_size, *out, ati)) {
+      types::BString tmp_string(value_ptr, value_size);
+      // reaching here, the parsing function should not be null
+      if (!parsers[col]) parsers[col] = types::ValueParserForText::GetParsingFuntion(ati);
+      if (parsers[col](tmp_string, *out) == common::ErrorCode::FAILED)
+        throw common::FormatException(0,
+                                      col);  // TODO: throw appropriate exception
+    }
     buffer.ExpectedSize(sizeof(int64_t));
   }
 }
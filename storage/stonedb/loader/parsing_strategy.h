@@ -18,6 +18,8 @@
 #define STONEDB_LOADER_PARSING_STRATEGY_H_
 #pragma once
 
+#include <functional>
+
 #include "common/data_format.h"
 #include "core/rc_attr_typeinfo.h"
 #include "loader/value_cache.h"
@@ -41,6 +43,8 @@ class ParsingStrategy final {
 
  private:
   std::vector<core::AttributeTypeInfo> atis;
+  // general parsers of the numeric and date/time columns, built once
+  std::vector<std::function<common::ErrorCode(types::BString const &, int64_t &)>> parsers;
   bool prepared;
 
   std::string eol;
@@ -18,6 +18,8 @@
 #include "loader/value_cache.h"
 
 #include <algorithm>
+#include <string>
+#include <unordered_set>
 
 #include "common/assert.h"
 #include "types/rc_data_types.h"
@@ -116,5 +118,21 @@ void ValueCache::CalcStrStats(types::BString &min_s, types::BString &max_s, uint
   }
 }
 
+size_t ValueCache::NumOfDistinct(size_t limit, const DTCollation &col) const {
+  // values equal in the collation have the same sort key
+  std::unordered_set<std::string> distinct;
+  std::string key;
+  for (size_t i = 0; i < values_.size() && distinct.size() <= limit; ++i) {
+    if (nulls_[i]) continue;
+    const char *v = GetDataBytesPointer(i);
+    size_t len = Size(i);
+    while (len > 0 && v[len - 1] == ' ') len--;  // ignored by the PAD SPACE collations
+    key.assign(types::CollationBufLen(col, int(len)), '\0');
+    common::strnxfrm(col, (uchar *)key.data(), key.size(), (const uchar *)v, len);
+    distinct.insert(key);
+  }
+  return distinct.size();
+}
+
 }  // namespace loader
 }  // namespace stonedb
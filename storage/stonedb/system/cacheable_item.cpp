@@ -92,12 +92,18 @@ void CacheableItem::CI_Put(int block, unsigned char *data, int size) {
     file_number.push_back(-1);
     file_size.push_back(0);
     file_start.push_back(0);
+    file_capacity.push_back(0);
   }
 
   try {
-    if (block >= no_block || size != file_size[block]) {
-      // create a new block or reallocate the existing one
-      if ((long long)(size) + (long long)(max_file_pos) > 2000000000) {  // the file size limit: 2 GB
+    if (block < no_block && size <= file_capacity[block]) {
+      // a block of variable size (e.g. a compressed page) is rewritten in place
+      file_size[block] = size;
+    } else {
+      // create a new block or reallocate the existing one; the extent has at
+      // least the default size, so that smaller rewrites of the block fit in it
+      int capacity = std::max(size, default_block_size);
+      if ((long long)(capacity) + (long long)(max_file_pos) > 2000000000) {  // the file size limit: 2 GB
         // file becomes too large, start the next one!
         max_file_id++;
         max_file_pos = 0;
@@ -106,11 +112,13 @@ void CacheableItem::CI_Put(int block, unsigned char *data, int size) {
         file_number.push_back(max_file_id);
         file_size.push_back(size);
         file_start.push_back(max_file_pos);
+        file_capacity.push_back(capacity);
         no_block = block + 1;
       } else {
         file_number[block] = max_file_id;
         file_size[block] = size;
         file_start[block] = max_file_pos;
+        file_capacity[block] = capacity;
       }
       cur_file_handle.Close();
       SetFilename(file_number[block]);
@@ -120,7 +128,7 @@ void CacheableItem::CI_Put(int block, unsigned char *data, int size) {
         cur_file_handle.OpenReadWrite(filename);
       DEBUG_ASSERT(cur_file_handle.IsOpen());
       cur_file_number = file_number[block];
-      max_file_pos += size;
+      max_file_pos += capacity;
     }
     // save the block
     if (file_number[block] != cur_file_number) {
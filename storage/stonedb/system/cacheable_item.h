@@ -67,12 +67,13 @@ class CacheableItem {
   size_t filename_n_position;  // the position of the first character of
                                // "nnnnnn" section of the file name
 
-  int max_file_id;               // maximal used file number, start with 0
-  int max_file_pos;              // the end of the last file used (here we will append)
-  int no_block;                  // the number of registered (saved) data blocks
-  std::vector<int> file_number;  // a number of file where the i-th data block is stored
-  std::vector<int> file_start;   // an address in the file where the i-th data block starts
-  std::vector<int> file_size;    // a size of the i-th data block
+  int max_file_id;                 // maximal used file number, start with 0
+  int max_file_pos;                // the end of the last file used (here we will append)
+  int no_block;                    // the number of registered (saved) data blocks
+  std::vector<int> file_number;    // a number of file where the i-th data block is stored
+  std::vector<int> file_start;     // an address in the file where the i-th data block starts
+  std::vector<int> file_size;      // a size of the i-th data block
+  std::vector<int> file_capacity;  // a size of the file extent reserved for the i-th data block
 
   int default_block_size;
   StoneDBFile cur_file_handle;
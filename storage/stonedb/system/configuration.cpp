@@ -73,6 +73,16 @@ char *stonedb_sysvar_async_join;
 char stonedb_sysvar_join_disable_switch_side;
 char stonedb_sysvar_enable_histogram_cmap_bloom;
 unsigned int stonedb_sysvar_result_sender_rows;
+my_bool stonedb_sysvar_spill_compression;
+char *stonedb_sysvar_rebuild_filters_columns;
+unsigned int stonedb_sysvar_rebuild_filters_packs;
+unsigned int stonedb_sysvar_rebuild_filters_threads;
+unsigned int stonedb_sysvar_union_threads;
+unsigned int stonedb_sysvar_index_join_max_rows;
+my_bool stonedb_sysvar_fallback_error;
+unsigned int stonedb_sysvar_join_cache_size;
+unsigned int stonedb_sysvar_lookup_advice;
+unsigned int stonedb_sysvar_groupby_parts_min_groups;
 
 async_join_setting stonedb_sysvar_async_join_setting;
 
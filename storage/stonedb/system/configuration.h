@@ -85,6 +85,31 @@ extern char stonedb_sysvar_enable_histogram_cmap_bloom;
 // The number of rows to load at a time when processing queries like select xxx
 // from yyy
 extern unsigned int stonedb_sysvar_result_sender_rows;
+// compress pages of intermediate results written to the disk cache
+extern char stonedb_sysvar_spill_compression;
+// OPTIMIZE TABLE rebuilds the rough indexes of these columns (comma separated,
+// empty: all columns), at most stonedb_sysvar_rebuild_filters_packs packs per
+// statement (0: no limit) with stonedb_sysvar_rebuild_filters_threads workers
+extern char *stonedb_sysvar_rebuild_filters_columns;
+extern unsigned int stonedb_sysvar_rebuild_filters_packs;
+extern unsigned int stonedb_sysvar_rebuild_filters_threads;
+// the number of UNION branches materialized concurrently (0: one by one)
+extern unsigned int stonedb_sysvar_union_threads;
+// a join on a primary key probes its index if the other side has at most
+// this many rows (0: never)
+extern unsigned int stonedb_sysvar_index_join_max_rows;
+// a query on StoneDB tables that would be executed by MySQL fails instead,
+// reporting why (for test suites checking that queries run natively)
+extern char stonedb_sysvar_fallback_error;
+// memory (MB) for hash tables of joins kept for other queries joining the same
+// filtered dimension (0: none)
+extern unsigned int stonedb_sysvar_join_cache_size;
+// the first LOAD into an empty table reports string columns with at most this
+// many distinct values in the first pack row as LOOKUP candidates (0: never)
+extern unsigned int stonedb_sysvar_lookup_advice;
+// parallel GROUP BY merges the tables of its workers by hash partitions, in
+// parallel, if they found at least this many groups
+extern unsigned int stonedb_sysvar_groupby_parts_min_groups;
 
 void ConfigureRCControl();
 
@@ -17,6 +17,7 @@
 #include "value_parser4txt.h"
 
 #include <cstring>
+#include <limits>
 
 #include "core/transaction.h"
 #include "my_time.h"
@@ -42,6 +43,45 @@ static int String2DateTime(const BString &s, RCDateTime &rcdt, common::CT at) {
   return 0;
 }
 
+// Digits of fixed length fields, e.g. "07", or false if not all are digits
+static inline bool FixedDigits(const char *ptr, int len, uint &out) {
+  out = 0;
+  for (int i = 0; i < len; i++) {
+    uint d = uint(uchar(ptr[i])) - '0';
+    if (d > 9) return false;
+    out = out * 10 + d;
+  }
+  return true;
+}
+
+// Up to 18 digits (no sign), 8 at a time: the bytes are checked and combined
+// in one 64-bit word (SWAR), the rest one by one
+static inline bool PlainDigits(const char *ptr, size_t len, uint64_t &out) {
+  if (len == 0 || len > 18) return false;
+  out = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; len >= 8; ptr += 8, len -= 8) {
+    uint64_t x;
+    std::memcpy(&x, ptr, sizeof(x));
+    if ((x & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL ||
+        ((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) != 0x3030303030303030ULL)
+      return false;
+    x -= 0x3030303030303030ULL;
+    x = (x * 10) + (x >> 8);  // pairs of digits
+    x = (((x & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((x >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+        32;
+    out = out * 100000000ULL + x;
+  }
+#endif
+  for (; len > 0; ptr++, len--) {
+    uint64_t d = uint64_t(uchar(*ptr)) - '0';
+    if (d > 9) return false;
+    out = out * 10 + d;
+  }
+  return true;
+}
+
 static inline bool EatWhiteSigns(char *&ptr, int &len) {
   bool vs = false;
   while (len > 0 && isspace((unsigned char)*ptr)) {
@@ -1067,5 +1107,103 @@ common::ErrorCode ValueParserForText::ParseDateTimeAdapter(BString const &rcs, i
   out = dt.GetInt64();
   return return_code;
 }
+
+bool ValueParserForText::ParseFast(const char *val, size_t len, int64_t &out, const core::AttributeTypeInfo &at) {
+  switch (at.Type()) {
+    case common::CT::BYTEINT:
+    case common::CT::SMALLINT:
+    case common::CT::MEDIUMINT:
+    case common::CT::INT:
+    case common::CT::BIGINT:
+      return ParseIntFast(val, len, out, at.Type());
+    case common::CT::NUM:
+      return ParseDecimalFast(val, len, out, at.Precision(), at.Scale());
+    case common::CT::DATE:
+      return ParseDateFast(val, len, out);
+    case common::CT::DATETIME:  // TIMESTAMP is converted to UTC, leave it to the general parser
+      return ParseDateTimeFast(val, len, out);
+    default:
+      return false;
+  }
+}
+
+bool ValueParserForText::ParseIntFast(const char *val, size_t len, int64_t &out, common::CT at) {
+  bool negative = (len > 0 && *val == '-');
+  if (negative) {
+    val++;
+    len--;
+  }
+  uint64_t v;
+  if (!PlainDigits(val, len, v)) return false;
+  out = negative ? -int64_t(v) : int64_t(v);
+  // out of range values are clamped (with a warning) by the general parser
+  switch (at) {
+    case common::CT::BYTEINT:
+      return out >= SDB_TINYINT_MIN && out <= SDB_TINYINT_MAX;
+    case common::CT::SMALLINT:
+      return out >= SDB_SMALLINT_MIN && out <= SDB_SMALLINT_MAX;
+    case common::CT::MEDIUMINT:
+      return out >= SDB_MEDIUMINT_MIN && out <= SDB_MEDIUMINT_MAX;
+    case common::CT::INT:
+      return out >= SDB_INT_MIN && out <= std::numeric_limits<int>::max();
+    default:
+      return true;  // 18 digits always fit
+  }
+}
+
+bool ValueParserForText::ParseDecimalFast(const char *val, size_t len, int64_t &out, short precision, short scale) {
+  bool negative = (len > 0 && *val == '-');
+  if (negative) {
+    val++;
+    len--;
+  }
+  const char *dot = static_cast<const char *>(std::memchr(val, '.', len));
+  size_t int_len = dot ? size_t(dot - val) : len;
+  size_t frac_len = dot ? len - int_len - 1 : 0;
+  if (int_len == 0 || (dot && frac_len == 0) || frac_len > size_t(scale) || int_len + scale > 18) return false;
+
+  uint64_t int_part, frac_part = 0;
+  if (!PlainDigits(val, int_len, int_part) || (frac_len > 0 && !PlainDigits(dot + 1, frac_len, frac_part)))
+    return false;
+  uint64_t v = int_part * Uint64PowOfTen(scale) + frac_part * Uint64PowOfTen(scale - short(frac_len));
+  if (v >= Uint64PowOfTen(precision)) return false;
+  out = negative ? -int64_t(v) : int64_t(v);
+  return true;
+}
+
+bool ValueParserForText::ParseDateFast(const char *val, size_t len, int64_t &out) {
+  // YYYY-MM-DD
+  uint year, month, day;
+  if (len != 10 || val[4] != '-' || val[7] != '-' || !FixedDigits(val, 4, year) ||
+      !FixedDigits(val + 5, 2, month) || !FixedDigits(val + 8, 2, day))
+    return false;
+  if (year < 1000 || !RCDateTime::CanBeDate(year, month, day)) return false;
+  out = RCDateTime(year, month, day, common::CT::DATE).GetInt64();
+  return true;
+}
+
+bool ValueParserForText::ParseDateTimeFast(const char *val, size_t len, int64_t &out) {
+  // YYYY-MM-DD HH:MM:SS
+  uint year, month, day, hour, minute, second;
+  if (len != 19 || val[4] != '-' || val[7] != '-' || val[10] != ' ' || val[13] != ':' || val[16] != ':' ||
+      !FixedDigits(val, 4, year) || !FixedDigits(val + 5, 2, month) || !FixedDigits(val + 8, 2, day) ||
+      !FixedDigits(val + 11, 2, hour) || !FixedDigits(val + 14, 2, minute) || !FixedDigits(val + 17, 2, second))
+    return false;
+  if (year < 1000 || !RCDateTime::CanBeDate(year, month, day) || !RCDateTime::CanBeHour(hour) ||
+      !RCDateTime::CanBeMinute(minute) || !RCDateTime::CanBeSecond(second))
+    return false;
+  // the same as String2DateTime() makes of it
+  MYSQL_TIME myt;
+  std::memset(&myt, 0, sizeof(MYSQL_TIME));
+  myt.year = year;
+  myt.month = month;
+  myt.day = day;
+  myt.hour = hour;
+  myt.minute = minute;
+  myt.second = second;
+  myt.time_type = MYSQL_TIMESTAMP_DATETIME;
+  out = RCDateTime(myt, common::CT::DATETIME).GetInt64();
+  return true;
+}
 }  // namespace types
 }  // namespace stonedb
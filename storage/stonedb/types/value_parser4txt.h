@@ -70,11 +70,22 @@ class ValueParserForText {
   static common::ErrorCode ParseReal(const BString &rcbs, RCNum &rcn, common::CT at);
   static common::ErrorCode ParseDateTime(const BString &rcs, RCDateTime &rcv, common::CT at);
 
+  // Fast path for the plain formats which make up most of LOAD files ("-123",
+  // "-12.50", "2022-01-31", "2022-01-31 12:00:00"). Returns false if the value
+  // must go through the function of GetParsingFuntion() (which also reports
+  // truncations and errors); if true, 'out' is the same as it would return.
+  static bool ParseFast(const char *val, size_t len, int64_t &out, const core::AttributeTypeInfo &at);
+
  private:
   static common::ErrorCode ParseDateTimeOrTimestamp(const BString &rcs, RCDateTime &rcv, common::CT at);
   static common::ErrorCode ParseTime(const BString &rcs, RCDateTime &rcv);
   static common::ErrorCode ParseDate(const BString &rcs, RCDateTime &rcv);
   static common::ErrorCode ParseYear(const BString &rcs, RCDateTime &rcv);
+
+  static bool ParseIntFast(const char *val, size_t len, int64_t &out, common::CT at);
+  static bool ParseDecimalFast(const char *val, size_t len, int64_t &out, short precision, short scale);
+  static bool ParseDateFast(const char *val, size_t len, int64_t &out);
+  static bool ParseDateTimeFast(const char *val, size_t len, int64_t &out);
 };
 
 }  // namespace types
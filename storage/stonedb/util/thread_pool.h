@@ -118,6 +118,11 @@ class result_set final {
   void get_all() {
     for (auto &&result : results) result.get();
   }
+  // wait for the tasks not retrieved yet, without their results or exceptions
+  void wait_all() {
+    for (auto &&result : results)
+      if (result.valid()) result.wait();
+  }
   void get_all_with_except() {
     bool no_except = true;
     for (auto &&result : results) try {
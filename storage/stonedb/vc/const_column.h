@@ -58,6 +58,16 @@ class ConstColumn : public VirtualColumn {
   int64_t GetValueInt64Impl([[maybe_unused]] const core::MIIterator &mit) override {
     return value.IsNull() ? common::NULL_VALUE_64 : value.Get64();
   }
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override {
+    int64_t v = GetValueInt64Impl(mit);
+    size_t n = 0;
+    while (n < max && mit.IsValid()) {
+      values[n++] = v;
+      ++mit;
+      if (mit.PackrowStarted()) break;
+    }
+    return n;
+  }
   bool IsNullImpl([[maybe_unused]] const core::MIIterator &mit) override { return value.IsNull(); }
   void GetValueStringImpl(types::BString &s, const core::MIIterator &mit) override;
   double GetValueDoubleImpl(const core::MIIterator &mit) override;
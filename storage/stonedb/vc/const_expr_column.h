@@ -90,6 +90,9 @@ class ConstExpressionColumn : public ExpressionColumn {
   int64_t GetValueInt64Impl([[maybe_unused]] const core::MIIterator &mit) override {
     return last_val->IsNull() ? common::NULL_VALUE_64 : last_val->Get64();
   }
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override {
+    return VirtualColumnBase::GetValuesInt64Impl(mit, values, max);
+  }
 
   double GetValueDoubleImpl(const core::MIIterator &mit) override;
   int64_t GetMinInt64Impl([[maybe_unused]] const core::MIIterator &mit) override {
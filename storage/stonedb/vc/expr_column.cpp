@@ -16,15 +16,21 @@
 */
 
 #include "expr_column.h"
+
+#include <cstring>
+
 #include "core/compiled_query.h"
 #include "core/mysql_expression.h"
 #include "core/rc_attr.h"
+#include "core/rc_table.h"
 
 namespace stonedb {
 namespace vcolumn {
 ExpressionColumn::ExpressionColumn(core::MysqlExpression *expr, core::TempTable *temp_table, int temp_table_alias,
                                    core::MultiIndex *mind)
-    : VirtualColumn(core::ColumnType(), mind), expr_(expr), deterministic_(expr ? expr->IsDeterministic() : true) {
+    : VirtualColumn(core::ColumnType(), mind),
+      expr_(expr),
+      deterministic_(expr ? expr->IsDeterministic() : true) {
   const std::vector<core::JustATable *> *tables = &temp_table->GetTables();
   const std::vector<int> *aliases = &temp_table->GetAliases();
 
@@ -68,6 +74,12 @@ ExpressionColumn::ExpressionColumn(core::MysqlExpression *expr, core::TempTable
       }
     }
     ct = core::ColumnType(expr_->EvalType(&var_types_));  // set the column type from expression result type
+    if (var_map.size() == 1 && params.empty() && var_map[0].GetTabPtr()->TableType() == core::TType::TABLE) {
+      dt_kernel_ = core::DateTimeKernel::Create(expr_->GetItem(), var_types_.begin()->second.attrtype, ct.GetTypeName());
+      if (!dt_kernel_) FindLengthKernel();
+      if (dt_kernel_ || length_kernel_) native_val_ = std::make_shared<core::ValueOrNull>();
+    }
+    if (var_map.size() == 2 && params.empty()) FindMultiIndex();
     expr->SetBufsOrParams(&var_buf_);
     //		expr->SetBufsOrParams(&param_buf);
     dim = (only_dim_number >= 0 ? only_dim_number : -1);
@@ -85,8 +97,21 @@ ExpressionColumn::ExpressionColumn(const ExpressionColumn &ec)
       vars_(ec.vars_),
       var_types_(ec.var_types_),
       var_buf_(ec.var_buf_),
-      deterministic_(ec.deterministic_) {
+      deterministic_(ec.deterministic_),
+      dt_kernel_(ec.dt_kernel_),
+      multi_index_no_(ec.multi_index_no_),
+      length_kernel_(ec.length_kernel_) {
   var_map = ec.var_map;
+  if (HasNativeKernel()) native_val_ = std::make_shared<core::ValueOrNull>();
+  first_eval = true;  // the cached arguments of 'ec' need not be in the buffers when this copy is used
+}
+
+bool ExpressionColumn::CanCopy() const {
+  // a core::TempTable cannot be read in parallel, as it may be paged
+  if (!params.empty()) return false;
+  for (auto &it : var_map)
+    if (it.GetTabPtr()->TableType() != core::TType::TABLE) return false;
+  return true;
 }
 
 void ExpressionColumn::SetParamTypes(core::MysqlExpression::TypOfVars *types) { expr_->EvalType(types); }
@@ -112,19 +137,201 @@ bool ExpressionColumn::FeedArguments(const core::MIIterator &mit) {
   return (diff || !deterministic_);
 }
 
+void ExpressionColumn::EvaluateItems(const core::MIIterator &mit, bool always) {
+  if (native_only_) {
+    native_failed_ = true;
+    *native_val_ = core::ValueOrNull();
+    last_val = native_val_;
+    return;
+  }
+  if (FeedArguments(mit) || always) last_val = expr_->Evaluate();
+}
+
+bool ExpressionColumn::EvaluateNative(const core::MIIterator &mit, int64_t &res) {
+  if (!HasNativeKernel() || mit.Type() == core::MIIterator::MIIteratorType::MII_LOOKUP) return false;
+  auto &it = var_map[0];
+  int64_t obj = mit[it.dim];
+  if (obj == common::NULL_VALUE_64) {  // null object, e.g. from outer join
+    res = common::NULL_VALUE_64;
+    return true;
+  }
+  if (length_kernel_) return EvaluateLength(it, obj, res);
+  core::PhysicalColumn *col = it.tabp->GetColumn(it.col_ndx);
+  if (!mit.WholePack(it.dim)) return dt_kernel_->Apply(col->GetValueInt64(obj), res);
+
+  // all rows of the pack will be needed: compute them in one pass
+  uint32_t power = it.tabp->Getpackpower();
+  int pack = mit.GetCurPackrow(it.dim);
+  int64_t start = int64_t(pack) << power;
+  if (pack != native_pack_) {
+    size_t n = size_t(std::min(int64_t(1) << power, it.tabp->NumOfObj() - start));
+    native_args_.resize(n);
+    native_res_.resize(n);
+    for (size_t i = 0; i < n; i++) native_args_[i] = start + i;
+    col->GetValuesInt64(native_args_.data(), n);
+    dt_kernel_->Apply(native_args_.data(), native_res_.data(), n, common::PLUS_INF_64);
+    native_pack_ = pack;
+  }
+  res = native_res_[obj - start];
+  return res != common::PLUS_INF_64;
+}
+
+bool ExpressionColumn::EvaluateLength(const VarMap &it, int64_t obj, int64_t &res) {
+  uint32_t power = it.tabp->Getpackpower();
+  int pack = int(obj >> power);
+  if (pack != native_pack_) {
+    length_nulls_.resize((size_t(1) << power) / 32);
+    length_res_.resize(size_t(1) << power);
+    static_cast<core::RCAttr *>(it.tabp->GetColumn(it.col_ndx))
+        ->GetPackProjection(pack, length_nulls_.data(), length_res_.data());
+    native_pack_ = pack;
+  }
+  int64_t row = obj & ((int64_t(1) << power) - 1);
+  res = ((length_nulls_[row >> 5] & (uint32_t(1) << (row % 32))) ? common::NULL_VALUE_64 : length_res_[row]);
+  return true;
+}
+
+void ExpressionColumn::FindLengthKernel() {
+  // MySQL strips the trailing spaces of CHAR values, the stored lengths need not match
+  auto &it = var_map[0];
+  auto type = it.GetTabPtr()->GetColumnType(it.col_ndx);
+  if (!ct.IsInt() || type.IsLookup() ||
+      (type.GetTypeName() != common::CT::VARCHAR && type.GetTypeName() != common::CT::VARBYTE &&
+       type.GetTypeName() != common::CT::BIN && type.GetTypeName() != common::CT::LONGTEXT))
+    return;
+  Item *item = expr_->GetItem();
+  if (item->type() != Item::FUNC_ITEM) return;
+  Item_func *ifunc = static_cast<Item_func *>(item);
+  if (ifunc->arg_count != 1 || std::strcmp(ifunc->func_name(), "length") != 0 ||
+      ifunc->arguments()[0]->type() != core::Item_sdbfield::get_sdbitem_type())
+    return;
+  length_kernel_ = true;
+}
+
+bool ExpressionColumn::NativeRoughRange(const core::MIIterator &mit, int64_t &res_min, int64_t &res_max) {
+  if (!dt_kernel_) return false;
+  auto &it = var_map[0];
+  int pack = mit.GetCurPackrow(it.dim);
+  if (pack < 0) return false;
+  core::PhysicalColumn *col = it.GetTabPtr()->GetColumn(it.col_ndx);
+  return dt_kernel_->RoughRange(col->GetMinInt64(pack), col->GetMaxInt64(pack), res_min, res_max);
+}
+
+void ExpressionColumn::FindMultiIndex() {
+  auto tab = var_map[0].GetTabPtr();
+  if (!tab || tab->TableType() != core::TType::TABLE || tab != var_map[1].GetTabPtr() ||
+      var_map[0].dim != var_map[1].dim || !ct.IsInt())
+    return;
+
+  Item *item = expr_->GetItem();
+  if (item->type() != Item::FUNC_ITEM) return;
+  Item_func *ifunc = static_cast<Item_func *>(item);
+  const char *name = ifunc->func_name();
+  if (ifunc->arg_count != 2 || std::strlen(name) != 1 || !std::strchr("+-*", name[0])) return;
+
+  int cols[2];
+  for (int k = 0; k < 2; k++) {
+    Item *arg = ifunc->arguments()[k];
+    if (arg->type() != core::Item_sdbfield::get_sdbitem_type()) return;
+    auto &var = static_cast<core::Item_sdbfield *>(arg)->varID[0];
+    auto it = std::find_if(var_map.begin(), var_map.end(), [&var](auto &vm) { return vm.var == var; });
+    if (it == var_map.end()) return;
+    cols[k] = it->col_ndx;
+  }
+
+  auto &defs = static_cast<core::RCTable *>(tab.get())->GetMultiIndexDefs();
+  for (size_t n = 0; n < defs.size(); n++) {
+    auto &def = defs[n];
+    if (def.kind != core::MultiIndexDef::Kind::EXPR || def.op != name[0]) continue;
+    if ((int(def.cols[0]) == cols[0] && int(def.cols[1]) == cols[1]) ||
+        (def.op != '-' && int(def.cols[0]) == cols[1] && int(def.cols[1]) == cols[0])) {
+      multi_index_no_ = n;
+      return;
+    }
+  }
+}
+
+bool ExpressionColumn::MultiIndexRange(const core::MIIterator &mit, int64_t &res_min, int64_t &res_max) {
+  if (multi_index_no_ < 0) return false;
+  auto &it = var_map[0];
+  int pack = mit.GetCurPackrow(it.dim);
+  if (pack < 0) return false;
+  if (!multi_index_) {
+    multi_index_ = static_cast<core::RCTable *>(it.GetTabPtr().get())->GetMultiIndex(multi_index_no_);
+    if (!multi_index_) {
+      multi_index_no_ = -1;  // not available for this version of the table
+      return false;
+    }
+  }
+  return multi_index_->GetRange(pack, res_min, res_max);
+}
+
+void ExpressionColumn::Evaluate(const core::MIIterator &mit) {
+  int64_t res;
+  if (!NativeStringResult() && EvaluateNative(mit, res)) {
+    if (res == common::NULL_VALUE_64)
+      *native_val_ = core::ValueOrNull();
+    else
+      native_val_->SetFixed(res);
+    last_val = native_val_;
+    return;
+  }
+  // the value cached by FeedArguments() may be older than the native results
+  EvaluateItems(mit, true);
+}
+
 int64_t ExpressionColumn::GetValueInt64Impl(const core::MIIterator &mit) {
-  if (FeedArguments(mit)) last_val = expr_->Evaluate();
+  if (HasNativeKernel()) {
+    int64_t res;
+    if (!NativeStringResult() && EvaluateNative(mit, res)) return res;
+    Evaluate(mit);
+  } else
+    EvaluateItems(mit, false);
   if (last_val->IsNull()) return common::NULL_VALUE_64;
   return last_val->Get64();
 }
 
+size_t ExpressionColumn::GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) {
+  if (!HasNativeKernel() || NativeStringResult()) return VirtualColumnBase::GetValuesInt64Impl(mit, values, max);
+  // the kernel is applied to the whole pack once, the rows are only picked from its results
+  size_t n = 0;
+  while (n < max && mit.IsValid()) {
+    int64_t &res = values[n++];
+    if (!EvaluateNative(mit, res)) {
+      Evaluate(mit);
+      res = (last_val->IsNull() ? common::NULL_VALUE_64 : last_val->Get64());
+    }
+    ++mit;
+    if (mit.PackrowStarted()) break;
+  }
+  return n;
+}
+
 bool ExpressionColumn::IsNullImpl(const core::MIIterator &mit) {
-  if (FeedArguments(mit)) last_val = expr_->Evaluate();
+  if (HasNativeKernel()) {
+    int64_t res;
+    if (EvaluateNative(mit, res)) return res == common::NULL_VALUE_64;
+    Evaluate(mit);
+  } else
+    EvaluateItems(mit, false);
   return last_val->IsNull();
 }
 
 void ExpressionColumn::GetValueStringImpl(types::BString &s, const core::MIIterator &mit) {
-  if (FeedArguments(mit)) last_val = expr_->Evaluate();
+  if (NativeStringResult()) {
+    int64_t arg;
+    if (EvaluateNative(mit, arg)) {
+      if (arg == common::NULL_VALUE_64)
+        s = types::BString();
+      else
+        dt_kernel_->Format(arg, s);
+      return;
+    }
+  }
+  if (HasNativeKernel())
+    Evaluate(mit);
+  else
+    EvaluateItems(mit, false);
   if (core::ATI::IsDateTimeType(TypeName())) {
     int64_t tmp;
     types::RCDateTime vd(last_val->Get64(), TypeName());
@@ -136,7 +343,10 @@ void ExpressionColumn::GetValueStringImpl(types::BString &s, const core::MIItera
 
 double ExpressionColumn::GetValueDoubleImpl(const core::MIIterator &mit) {
   double val = 0;
-  if (FeedArguments(mit)) last_val = expr_->Evaluate();
+  if (HasNativeKernel())
+    Evaluate(mit);
+  else
+    EvaluateItems(mit, false);
   if (last_val->IsNull()) val = NULL_VALUE_D;
 
   if (core::ATI::IsIntegerType(TypeName()))
@@ -179,11 +389,15 @@ int64_t ExpressionColumn::GetSumImpl([[maybe_unused]] const core::MIIterator &mi
   return common::NULL_VALUE_64;  // not implemented
 }
 
-int64_t ExpressionColumn::GetMinInt64Impl([[maybe_unused]] const core::MIIterator &mit) {
+int64_t ExpressionColumn::GetMinInt64Impl(const core::MIIterator &mit) {
+  int64_t res_min, res_max;
+  if (NativeRoughRange(mit, res_min, res_max) || MultiIndexRange(mit, res_min, res_max)) return res_min;
   return common::MINUS_INF_64;  // not implemented
 }
 
-int64_t ExpressionColumn::GetMaxInt64Impl([[maybe_unused]] const core::MIIterator &mit) {
+int64_t ExpressionColumn::GetMaxInt64Impl(const core::MIIterator &mit) {
+  int64_t res_min, res_max;
+  if (NativeRoughRange(mit, res_min, res_max) || MultiIndexRange(mit, res_min, res_max)) return res_max;
   return common::PLUS_INF_64;  // not implemented
 }
 
@@ -281,6 +495,7 @@ void ExpressionColumn::FeedLookupArguments(core::MILookupIterator &mit) {
 
 void ExpressionColumn::LockSourcePacks(const core::MIIterator &mit) {
   for (auto &it : var_map) it.tabp = it.GetTabPtr().get();
+  if (length_kernel_) return;  // the lengths are read without loading the packs
   VirtualColumn::LockSourcePacks(mit);
 }
 }  // namespace vcolumn
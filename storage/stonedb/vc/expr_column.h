@@ -18,10 +18,11 @@
 #define STONEDB_VC_EXPR_COLUMN_H_
 #pragma once
 
-#include <mutex>
 
+#include "core/datetime_kernel.h"
 #include "core/mi_updating_iterator.h"
 #include "core/pack_guardian.h"
+#include "core/rsi_multi.h"
 #include "vc/virtual_column.h"
 
 namespace stonedb {
@@ -65,6 +66,16 @@ class ExpressionColumn : public VirtualColumn {
   void SetParamTypes(core::MysqlExpression::TypOfVars *types) override;
   bool IsConst() const override { return false; }
   bool IsDeterministic() override { return expr_->IsDeterministic(); }
+  // copies may be used in parallel if the arguments are read from base tables
+  bool CanCopy() const override;
+  bool HasNativeKernel() const { return dt_kernel_ != nullptr || length_kernel_; }
+  /*! \brief Never evaluate by the item tree, e.g. in a copy used in parallel.
+   *
+   * A row the native kernel cannot compute gets a null value and sets NativeFailed(),
+   * the caller must then compute the rows again with the original column.
+   */
+  void SetNativeOnly() { native_only_ = true; }
+  bool NativeFailed() const { return native_failed_; }
   int64_t GetNotNullValueInt64(const core::MIIterator &mit) override { return GetValueInt64Impl(mit); }
   void GetNotNullValueString(types::BString &s, const core::MIIterator &mit) override { GetValueStringImpl(s, mit); }
   core::MysqlExpression::StringType GetStringType() { return expr_->GetStringType(); }
@@ -81,6 +92,7 @@ class ExpressionColumn : public VirtualColumn {
   /////////////// Data access //////////////////////
  protected:
   int64_t GetValueInt64Impl(const core::MIIterator &) override;
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override;
   bool IsNullImpl(const core::MIIterator &) override;
   void GetValueStringImpl(types::BString &, const core::MIIterator &) override;
   double GetValueDoubleImpl(const core::MIIterator &) override;
@@ -122,6 +134,28 @@ class ExpressionColumn : public VirtualColumn {
    * existing.
    */
   bool FeedArguments(const core::MIIterator &mit);
+  //! set last_val by core::MysqlExpression, if the arguments changed or 'always'
+  void EvaluateItems(const core::MIIterator &mit, bool always);
+
+  /*! \brief Compute the expression without MySQL, if a native kernel is available.
+   *
+   * \param res - the result (packed date/time, integer or common::NULL_VALUE_64).
+   * \return false if the row must be evaluated by core::MysqlExpression.
+   */
+  bool EvaluateNative(const core::MIIterator &mit, int64_t &res);
+  //! LENGTH() of the current row, read from the length projection of its pack
+  bool EvaluateLength(const VarMap &it, int64_t obj, int64_t &res);
+  //! recognize LENGTH() of a string column of a base table
+  void FindLengthKernel();
+  bool NativeStringResult() const { return dt_kernel_ && dt_kernel_->StringResult(); }
+  //! rough range of the native kernel result on the current pack
+  bool NativeRoughRange(const core::MIIterator &mit, int64_t &res_min, int64_t &res_max);
+  //! set last_val for the current row, natively if possible
+  void Evaluate(const core::MIIterator &mit);
+  //! find a ROUGH_INDEX(a*b) declared for the expression
+  void FindMultiIndex();
+  //! expression range on the current pack kept by the rough index
+  bool MultiIndexRange(const core::MIIterator &mit, int64_t &res_min, int64_t &res_max);
 
   // if ExpressionColumn ExpressionColumn encapsulates an expression these sets
   // are used to interface with core::MysqlExpression
@@ -132,6 +166,26 @@ class ExpressionColumn : public VirtualColumn {
   //! value for a given row is always the same or not? e.g. currenttime() is not
   //! deterministic
   bool deterministic_;
+
+  // native evaluation of date/time functions of a single base table column
+  std::shared_ptr<core::DateTimeKernel> dt_kernel_;
+  std::shared_ptr<core::ValueOrNull> native_val_;
+  std::vector<int64_t> native_args_;  // arguments of a whole pack
+  std::vector<int64_t> native_res_;   // kernel results for a whole pack
+  int native_pack_ = -1;              // pack number cached in native_res_ or length_res_
+
+  // LENGTH() of a string column, computed without decompressing its values
+  bool length_kernel_ = false;
+  std::vector<uint32_t> length_nulls_;  // null mask of the cached pack
+  std::vector<uint32_t> length_res_;    // value lengths of the cached pack
+
+  // ROUGH_INDEX(a*b) of the base table matching the expression
+  int multi_index_no_ = -1;
+  std::shared_ptr<core::RSIndex_Multi> multi_index_;
+
+  // a copy may not use the item tree of expr_, which is shared with the original
+  bool native_only_ = false;
+  bool native_failed_ = false;  // a row of a native only copy needed the item tree
 };
 }  // namespace vcolumn
 }  // namespace stonedb
@@ -42,6 +42,18 @@ void SingleColumn::TranslateSourceColumns(std::map<core::PhysicalColumn *, core:
   if (attr_translation.find(col_) != attr_translation.end()) col_ = attr_translation[col_];
 }
 
+size_t SingleColumn::GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) {
+  // collect the row numbers first, then decode them all in one call
+  size_t n = 0;
+  while (n < max && mit.IsValid()) {
+    values[n++] = mit[dim];
+    ++mit;
+    if (mit.PackrowStarted()) break;
+  }
+  col_->GetValuesInt64(values, n);
+  return n;
+}
+
 double SingleColumn::GetValueDoubleImpl(const core::MIIterator &mit) {
   double val = 0;
   if (col_->IsNull(mit[dim])) {
@@ -72,6 +72,7 @@ class SingleColumn : public VirtualColumn {
 
  protected:
   int64_t GetValueInt64Impl(const core::MIIterator &mit) override { return col_->GetValueInt64(mit[dim]); }
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override;
   bool IsNullImpl(const core::MIIterator &mit) override { return col_->IsNull(mit[dim]); }
   void GetValueStringImpl(types::BString &s, const core::MIIterator &mit) override {
     col_->GetValueString(mit[dim], s);
@@ -60,6 +60,9 @@ class TypeCastColumn : public VirtualColumn {
 
  protected:
   int64_t GetValueInt64Impl(const core::MIIterator &mit) override { return vc->GetValueInt64(mit); }
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override {
+    return vc->GetValuesInt64(mit, values, max);
+  }
   bool IsNullImpl(const core::MIIterator &mit) override { return vc->IsNull(mit); }
   void GetValueStringImpl(types::BString &s, const core::MIIterator &m) override { return vc->GetValueString(s, m); }
   double GetValueDoubleImpl(const core::MIIterator &m) override { return vc->GetValueDouble(m); }
@@ -112,6 +115,9 @@ class String2NumCastColumn : public TypeCastColumn {
   virtual bool IsDistinctInTable() override { return false; }  // cast may make distinct strings equal
  protected:
   int64_t GetValueInt64Impl(const core::MIIterator &mit) override;
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override {
+    return VirtualColumnBase::GetValuesInt64Impl(mit, values, max);  // converted one by one
+  }
   types::RCValueObject GetValueImpl(const core::MIIterator &, bool lookup_to_num = true) override;
   int64_t GetMinInt64Impl(const core::MIIterator &m) override;
   int64_t GetMaxInt64Impl(const core::MIIterator &m) override;
@@ -130,6 +136,9 @@ class String2DateTimeCastColumn : public TypeCastColumn {
   bool IsDistinctInTable() override { return false; }  // cast may make distinct strings equal
  protected:
   int64_t GetValueInt64Impl(const core::MIIterator &mit) override;
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override {
+    return VirtualColumnBase::GetValuesInt64Impl(mit, values, max);  // converted one by one
+  }
   types::RCValueObject GetValueImpl(const core::MIIterator &, bool lookup_to_num = true) override;
   void GetValueStringImpl(types::BString &s, const core::MIIterator &m) override;
   int64_t GetMinInt64Impl(const core::MIIterator &m) override;
@@ -192,6 +201,9 @@ class DateTime2NumCastColumn : public TypeCastColumn {
 
  protected:
   int64_t GetValueInt64Impl(const core::MIIterator &mit) override;
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override {
+    return VirtualColumnBase::GetValuesInt64Impl(mit, values, max);  // converted one by one
+  }
   types::RCValueObject GetValueImpl(const core::MIIterator &, bool lookup_to_num = true) override;
   double GetValueDoubleImpl(const core::MIIterator &mit) override;
 
@@ -208,6 +220,9 @@ class TimeZoneConversionCastColumn : public TypeCastColumn {
 
  protected:
   int64_t GetValueInt64Impl(const core::MIIterator &mit) override;
+  size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) override {
+    return VirtualColumnBase::GetValuesInt64Impl(mit, values, max);  // converted one by one
+  }
   types::RCValueObject GetValueImpl(const core::MIIterator &, bool lookup_to_num = true) override;
   double GetValueDoubleImpl(const core::MIIterator &m) override;
   void GetValueStringImpl(types::BString &s, const core::MIIterator &m) override;
@@ -162,6 +162,17 @@ int64_t VirtualColumnBase::GetApproxDistVals(bool incl_nulls, core::RoughMultiIn
   return res;
 }
 
+size_t VirtualColumnBase::GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max) {
+  // row by row; columns able to do better override it
+  size_t n = 0;
+  while (n < max && mit.IsValid()) {
+    values[n++] = GetValueInt64Impl(mit);
+    ++mit;
+    if (mit.PackrowStarted()) break;
+  }
+  return n;
+}
+
 int64_t VirtualColumnBase::GetMaxInt64(const core::MIIterator &mit) {
   int64_t res = GetMaxInt64Impl(mit);
   DEBUG_ASSERT(res != common::NULL_VALUE_64);
@@ -93,6 +93,22 @@ class VirtualColumnBase : public core::Column {
   inline int64_t GetValueInt64(const core::MIIterator &mit) { return GetValueInt64Impl(mit); }
   virtual int64_t GetNotNullValueInt64(const core::MIIterator &mit) = 0;
 
+  /*! \brief Get numeric values of consecutive rows
+   *
+   * \pre necessary datapacks (of the packrow \e mit points to) are loaded and
+   * locked
+   *
+   * Reads GetValueInt64() of the rows from the current position of \e mit up
+   * to the end of its packrow, at most \e max of them, and advances \e mit
+   * past the rows read. Nulls are returned as common::NULL_VALUE_64, as in
+   * GetValueInt64().
+   *
+   * \return number of values stored in \e values, not 0 if \e mit is valid
+   */
+  inline size_t GetValuesInt64(core::MIIterator &mit, int64_t *values, size_t max) {
+    return GetValuesInt64Impl(mit, values, max);
+  }
+
   /*! \brief Is the column value NULL ?
    *
    * \pre necessary datapacks (containing rows pointed by \e mit) are loaded and
@@ -481,6 +497,7 @@ class VirtualColumnBase : public core::Column {
 
  protected:
   virtual int64_t GetValueInt64Impl(const core::MIIterator &) = 0;
+  virtual size_t GetValuesInt64Impl(core::MIIterator &mit, int64_t *values, size_t max);
   virtual bool IsNullImpl(const core::MIIterator &) = 0;
   virtual void GetValueStringImpl(types::BString &, const core::MIIterator &) = 0;
   virtual double GetValueDoubleImpl(const core::MIIterator &) = 0;